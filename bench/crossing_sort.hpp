@@ -0,0 +1,117 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <mapbox/geometry/wagyu/crossing_sort.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// A sorted list of n values where each value is moved up to `spread` places,
+// the number of bubble sort passes needed grows with the spread.
+inline std::vector<double> crossing_sort_input(std::size_t n, std::size_t spread) {
+    std::mt19937 rng(42);
+    std::vector<double> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<double>(i);
+    }
+    std::uniform_int_distribution<std::size_t> dist(0, spread);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        std::size_t j = std::min(n - 1, i + dist(rng));
+        std::swap(values[i], values[j]);
+    }
+    return values;
+}
+
+// A sorted list of n values where `movers` of the smallest values are moved to random places
+// in the second half, bubble sort needs a pass for every place they have to move back.
+inline std::vector<double> crossing_sort_movers_input(std::size_t n, std::size_t movers) {
+    std::mt19937 rng(42);
+    std::vector<double> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<double>(i);
+    }
+    std::uniform_int_distribution<std::size_t> dist(n / 2, n - 1);
+    for (std::size_t i = 0; i < movers; ++i) {
+        double v = values.front();
+        values.erase(values.begin());
+        values.insert(values.begin() + static_cast<std::ptrdiff_t>(dist(rng)), v);
+    }
+    return values;
+}
+
+auto BM_crossing_sort = [](benchmark::State& state,
+                           mapbox::geometry::wagyu::crossing_sort_type method,
+                           bool movers) {
+    std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::size_t r = static_cast<std::size_t>(state.range(1));
+    auto input = movers ? crossing_sort_movers_input(n, r) : crossing_sort_input(n, r);
+    std::size_t swaps = 0;
+    while (state.KeepRunning()) {
+        std::vector<double> values = input;
+        swaps = 0;
+        mapbox::geometry::wagyu::crossing_sort(values.begin(), values.end(), [](double v) { return v; },
+                                               [](double a, double b) { return a <= b; },
+                                               [&swaps](double, double) { ++swaps; }, method);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.counters["swaps"] = static_cast<double>(swaps);
+};
+
+// Many long thin bars rotated around a common center, every bar crosses every other
+inline mapbox::geometry::multi_polygon<std::int64_t> crossing_bars(std::size_t count) {
+    mapbox::geometry::multi_polygon<std::int64_t> result;
+    double const pi = 3.14159265358979323846;
+    for (std::size_t i = 0; i < count; ++i) {
+        double angle = pi * static_cast<double>(i) / static_cast<double>(count);
+        double c = std::cos(angle);
+        double s = std::sin(angle);
+        double length = 1000000.0;
+        double width = 10.0;
+        mapbox::geometry::linear_ring<std::int64_t> ring;
+        double xs[4] = { -length, length, length, -length };
+        double ys[4] = { -width, -width, width, width };
+        for (std::size_t k = 0; k < 4; ++k) {
+            ring.push_back({ static_cast<std::int64_t>(std::llround(xs[k] * c - ys[k] * s)),
+                             static_cast<std::int64_t>(std::llround(xs[k] * s + ys[k] * c)) });
+        }
+        ring.push_back(ring.front());
+        result.push_back({ ring });
+    }
+    return result;
+}
+
+auto BM_wagyu_crossing_bars = [](benchmark::State& state, mapbox::geometry::wagyu::crossing_sort_type method) {
+    auto bars = crossing_bars(static_cast<std::size_t>(state.range(0)));
+    mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+    clipper.set_crossing_sort(method);
+    while (state.KeepRunning()) {
+        clipper.clear();
+        for (auto const& p : bars) {
+            clipper.add_polygon(p, mapbox::geometry::wagyu::polygon_type_subject);
+        }
+        mapbox::geometry::multi_polygon<std::int64_t> solution;
+        clipper.execute(mapbox::geometry::wagyu::clip_type_union, solution, mapbox::geometry::wagyu::fill_type_non_zero,
+                        mapbox::geometry::wagyu::fill_type_non_zero);
+    }
+};
+
+inline void register_crossing_sort() {
+    using namespace mapbox::geometry::wagyu;
+    for (auto m : { crossing_sort_bubble, crossing_sort_merge, crossing_sort_adaptive }) {
+        std::string name = m == crossing_sort_bubble ? "bubble" : (m == crossing_sort_merge ? "merge" : "adaptive");
+        auto* spread = benchmark::RegisterBenchmark(("BM_crossing_sort_spread_" + name).c_str(), BM_crossing_sort, m, false);
+        auto* movers = benchmark::RegisterBenchmark(("BM_crossing_sort_movers_" + name).c_str(), BM_crossing_sort, m, true);
+        for (std::int64_t n : { 64, 1024, 8192 }) {
+            for (std::int64_t r : { 1, 4, 16, 64 }) {
+                spread->Args({ n, r });
+                movers->Args({ n, r });
+            }
+        }
+        benchmark::RegisterBenchmark(("BM_wagyu_crossing_bars_" + name).c_str(), BM_wagyu_crossing_bars, m)
+            ->Arg(16)
+            ->Arg(64)
+            ->Arg(256);
+    }
+}
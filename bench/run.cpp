@@ -1,8 +1,14 @@
+#include "crossing_sort.hpp"
 #include "fixtures.hpp"
+#include "scanbeam.hpp"
+#include "threads.hpp"
 #include <benchmark/benchmark.h>
 
 int main(int argc, char* argv[]) {
     register_fixtures();
+    register_crossing_sort();
+    register_scanbeam();
+    register_threads();
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
 
@@ -0,0 +1,112 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Replays the scanbeam traffic of a sweep with `minima` local minima spread over y values up to
+// 100000000. Every stop pushes the top of the next edge, which ends up to `span` further on,
+// until the edges reach y = 0. The larger the span the more values are waiting in the queue
+// between a new top and the next stop.
+template <typename Insert, typename Pop, typename Setup>
+void run_scanbeam_sweep(benchmark::State& state, Insert insert, Pop pop, Setup setup) {
+    using namespace mapbox::geometry::wagyu;
+    std::size_t minima = static_cast<std::size_t>(state.range(0));
+    std::int64_t span = state.range(1);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::int64_t> y_dist(0, 100000000);
+    std::uniform_int_distribution<std::int64_t> step_dist(1, span);
+    local_minimum_list<std::int64_t> minima_list;
+    for (std::size_t i = 0; i < minima; ++i) {
+        minima_list.emplace_back(bound<std::int64_t>(), bound<std::int64_t>(), y_dist(rng), false);
+    }
+    std::vector<std::int64_t> steps(1 << 16);
+    for (auto& s : steps) {
+        s = step_dist(rng);
+    }
+    std::size_t stops = 0;
+    while (state.KeepRunning()) {
+        scanbeam_list<std::int64_t> scanbeam;
+        setup(minima_list, scanbeam);
+        std::int64_t y = 0;
+        std::size_t i = 0;
+        stops = 0;
+        while (pop(y, scanbeam)) {
+            ++stops;
+            std::int64_t top = y - steps[i++ & (steps.size() - 1)];
+            if (top >= 0) {
+                insert(scanbeam, top);
+            }
+        }
+        benchmark::DoNotOptimize(y);
+    }
+    state.counters["stops"] = static_cast<double>(stops);
+}
+
+auto BM_scanbeam_sorted = [](benchmark::State& state) {
+    using namespace mapbox::geometry::wagyu;
+    run_scanbeam_sweep(state, insert_scanbeam_sorted<std::int64_t>, pop_from_scanbeam_sorted<std::int64_t>,
+                       setup_scanbeam_sorted<std::int64_t>);
+};
+
+auto BM_scanbeam_heap = [](benchmark::State& state) {
+    using namespace mapbox::geometry::wagyu;
+    run_scanbeam_sweep(state, insert_scanbeam_heap<std::int64_t>, pop_from_scanbeam_heap<std::int64_t>,
+                       setup_scanbeam_heap<std::int64_t>);
+};
+
+// `count` tall thin stripes side by side, each with `vertices` vertices at y values that no other
+// stripe shares, like dense contour lines. Many edge tops are waiting in the scanbeam at once.
+inline mapbox::geometry::multi_polygon<std::int64_t> zigzag_stripes(std::size_t count, std::size_t vertices) {
+    mapbox::geometry::multi_polygon<std::int64_t> result;
+    std::int64_t height = 100000000;
+    std::int64_t n = static_cast<std::int64_t>(vertices / 2);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::int64_t x = static_cast<std::int64_t>(i) * 100;
+        std::int64_t offset = static_cast<std::int64_t>(i) * 7;
+        mapbox::geometry::linear_ring<std::int64_t> ring;
+        for (std::int64_t k = 0; k < n; ++k) {
+            ring.push_back({ x + (k % 2) * 20, offset + k * (height / n) });
+        }
+        for (std::int64_t k = n - 1; k >= 0; --k) {
+            ring.push_back({ x + 50 + (k % 2) * 20, offset + k * (height / n) + 3 });
+        }
+        ring.push_back(ring.front());
+        result.push_back({ ring });
+    }
+    return result;
+}
+
+// Runs with whichever scanbeam queue wagyu.hpp was compiled with
+auto BM_wagyu_zigzag_stripes = [](benchmark::State& state) {
+    auto stripes = zigzag_stripes(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    while (state.KeepRunning()) {
+        mapbox::geometry::wagyu::wagyu<std::int64_t> clipper;
+        for (auto const& p : stripes) {
+            clipper.add_polygon(p, mapbox::geometry::wagyu::polygon_type_subject);
+        }
+        mapbox::geometry::multi_polygon<std::int64_t> solution;
+        clipper.execute(mapbox::geometry::wagyu::clip_type_union, solution, mapbox::geometry::wagyu::fill_type_even_odd,
+                        mapbox::geometry::wagyu::fill_type_even_odd);
+    }
+};
+
+inline void register_scanbeam() {
+    for (auto* b : { benchmark::RegisterBenchmark("BM_scanbeam_sorted", BM_scanbeam_sorted),
+                     benchmark::RegisterBenchmark("BM_scanbeam_heap", BM_scanbeam_heap) }) {
+        for (std::int64_t minima : { 1000, 10000, 100000 }) {
+            for (std::int64_t span : { 10000000, 100000000 }) {
+                b->Args({ minima, span });
+            }
+        }
+    }
+#ifdef USE_WAGYU_SCANBEAM_HEAP
+    char const* name = "BM_wagyu_zigzag_stripes_heap";
+#else
+    char const* name = "BM_wagyu_zigzag_stripes_sorted";
+#endif
+    benchmark::RegisterBenchmark(name, BM_wagyu_zigzag_stripes)->Args({ 100, 200 })->Args({ 400, 100 });
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// A random walk of `vertices` vertices over a square, closed into one ring. The whole input is a
+// single piece crossing itself all over, so it can not be split into clusters.
+inline mapbox::geometry::polygon<std::int64_t> scribble(std::size_t vertices) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::int64_t> step(-20000, 20000);
+    std::int64_t size = 1000000;
+    mapbox::geometry::linear_ring<std::int64_t> ring;
+    std::int64_t x = size / 2;
+    std::int64_t y = size / 2;
+    for (std::size_t i = 0; i < vertices; ++i) {
+        ring.push_back({ x, y });
+        x = std::min(size, std::max(std::int64_t(0), x + step(rng)));
+        y = std::min(size, std::max(std::int64_t(0), y + step(rng)));
+    }
+    ring.push_back(ring.front());
+    return { ring };
+}
+
+// Snap rounding of the scribble in as many horizontal bands as threads
+auto BM_hot_pixel_bands = [](benchmark::State& state) {
+    using namespace mapbox::geometry::wagyu;
+    std::size_t threads = static_cast<std::size_t>(state.range(1));
+    local_minimum_list<std::int64_t> minima_list;
+    add_linear_ring(scribble(static_cast<std::size_t>(state.range(0))).front(), minima_list, polygon_type_subject);
+    auto& minima_sorted = sort_local_minima(minima_list);
+    std::size_t hot_pixels = 0;
+    while (state.KeepRunning()) {
+        ring_manager<std::int64_t> manager;
+        if (threads > 1) {
+            build_hot_pixels_in_bands(minima_sorted, manager, threads, get_default_resource());
+        } else {
+            build_hot_pixels(minima_sorted, manager);
+        }
+        hot_pixels = manager.hot_pixels.size();
+    }
+    state.counters["hot_pixels"] = static_cast<double>(hot_pixels);
+};
+
+auto BM_wagyu_scribble_threads = [](benchmark::State& state) {
+    using namespace mapbox::geometry::wagyu;
+    auto subject = scribble(static_cast<std::size_t>(state.range(0)));
+    while (state.KeepRunning()) {
+        wagyu<std::int64_t> clipper;
+        clipper.set_threads(static_cast<std::size_t>(state.range(1)));
+        clipper.add_polygon(subject, polygon_type_subject);
+        mapbox::geometry::multi_polygon<std::int64_t> solution;
+        clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    }
+};
+
+inline void register_threads() {
+    for (std::int64_t threads : { 1, 2, 4, 8 }) {
+        benchmark::RegisterBenchmark("BM_hot_pixel_bands", BM_hot_pixel_bands)
+            ->Args({ 20000, threads })
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark("BM_wagyu_scribble_threads", BM_wagyu_scribble_threads)
+            ->Args({ 10000, threads })
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    }
+}
@@ -14,12 +14,15 @@
 #include <mapbox/geometry/wagyu/scanbeam.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
 template <typename T>
-using active_bound_list = std::vector<bound_ptr<T>>;
+using active_bound_list = std::vector<bound_ptr<T>, resource_allocator<bound_ptr<T>>>;
 
 template <typename T>
 using active_bound_list_itr = typename active_bound_list<T>::iterator;
@@ -60,8 +63,8 @@ std::string output_edges(active_bound_list<T> const& bnds) {
 
 #endif
 
-template <typename T>
-bool is_even_odd_fill_type(bound<T> const& bound, fill_type subject_fill_type, fill_type clip_fill_type) {
+template <typename T, typename SubjectFill, typename ClipFill>
+bool is_even_odd_fill_type(bound<T> const& bound, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
     if (bound.poly_type == polygon_type_subject) {
         return subject_fill_type == fill_type_even_odd;
     } else {
@@ -69,8 +72,8 @@ bool is_even_odd_fill_type(bound<T> const& bound, fill_type subject_fill_type, f
     }
 }
 
-template <typename T>
-bool is_even_odd_alt_fill_type(bound<T> const& bound, fill_type subject_fill_type, fill_type clip_fill_type) {
+template <typename T, typename SubjectFill, typename ClipFill>
+bool is_even_odd_alt_fill_type(bound<T> const& bound, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
     if (bound.poly_type == polygon_type_subject) {
         return clip_fill_type == fill_type_even_odd;
     } else {
@@ -102,16 +105,86 @@ struct bound_insert_location {
     }
 };
 
+/**
+ * Each bound keeps its index in the active bound list in `pos`, so that it can be found
+ * without searching the list. It is updated wherever the list is reordered during the
+ * sweep, but it is only ever a hint: it is checked before use and a stale one falls back
+ * to a linear search.
+ */
+
 template <typename T>
-active_bound_list_itr<T> insert_bound_into_ABL(bound<T>& left, bound<T>& right, active_bound_list<T>& active_bounds) {
+void update_bound_positions(active_bound_list<T>& active_bounds, std::size_t first) {
+    for (std::size_t pos = first; pos < active_bounds.size(); ++pos) {
+        if (active_bounds[pos] != nullptr) {
+            active_bounds[pos]->pos = pos;
+        }
+    }
+}
+
+template <typename T>
+active_bound_list_itr<T> find_bound(bound_ptr<T> bnd, active_bound_list<T>& active_bounds) {
+    if (bnd != nullptr && bnd->pos < active_bounds.size() && active_bounds[bnd->pos] == bnd) {
+        return active_bounds.begin() + static_cast<std::ptrdiff_t>(bnd->pos);
+    }
+    return std::find(active_bounds.begin(), active_bounds.end(), bnd);
+}
+
+template <typename T>
+typename active_bound_list<T>::const_iterator find_bound(bound_ptr<T> bnd, active_bound_list<T> const& active_bounds) {
+    if (bnd != nullptr && bnd->pos < active_bounds.size() && active_bounds[bnd->pos] == bnd) {
+        return active_bounds.begin() + static_cast<std::ptrdiff_t>(bnd->pos);
+    }
+    return std::find(active_bounds.begin(), active_bounds.end(), bnd);
+}
+
+template <typename T>
+void swap_bounds(active_bound_list_itr<T> b1, active_bound_list_itr<T> b2, active_bound_list<T>& active_bounds) {
+    std::iter_swap(b1, b2);
+    if (*b1 != nullptr) {
+        (*b1)->pos = static_cast<std::size_t>(std::distance(active_bounds.begin(), b1));
+    }
+    if (*b2 != nullptr) {
+        (*b2)->pos = static_cast<std::size_t>(std::distance(active_bounds.begin(), b2));
+    }
+}
+
+template <typename T>
+void swap_bounds(active_bound_list_rev_itr<T> b1,
+                 active_bound_list_rev_itr<T> b2,
+                 active_bound_list<T>& active_bounds) {
+    swap_bounds<T>(std::prev(b1.base()), std::prev(b2.base()), active_bounds);
+}
+
+// Erases bounds that were set to null, only positions after the first one removed change
+template <typename T>
+void remove_null_bounds(active_bound_list<T>& active_bounds) {
+    auto first = std::find(active_bounds.begin(), active_bounds.end(), nullptr);
+    if (first == active_bounds.end()) {
+        return;
+    }
+    std::size_t pos = static_cast<std::size_t>(std::distance(active_bounds.begin(), first));
+    active_bounds.erase(std::remove(first, active_bounds.end(), nullptr), active_bounds.end());
+    update_bound_positions(active_bounds, pos);
+}
 
-    auto itr = std::find_if(active_bounds.begin(), active_bounds.end(), bound_insert_location<T>(left));
+template <typename T>
+active_bound_list_itr<T> insert_bound_into_ABL(bound<T>& left, bound<T>& right, active_bound_list<T>& active_bounds) {
+    // The list is ordered by current_x, so everything clearly to the left of the new bound
+    // can be skipped with a binary search before the exact insert location is found.
+    double x = left.current_x;
+    auto itr = std::partition_point(active_bounds.begin(), active_bounds.end(), [x](bound_ptr<T> const& b) {
+        return b->current_x < x && !values_are_equal(b->current_x, x);
+    });
+    itr = std::find_if(itr, active_bounds.end(), bound_insert_location<T>(left));
+    std::size_t pos = static_cast<std::size_t>(std::distance(active_bounds.begin(), itr));
 #ifdef GCC_MISSING_VECTOR_RANGE_INSERT
     itr = active_bounds.insert(itr, &right);
-    return active_bounds.insert(itr, &left);
+    itr = active_bounds.insert(itr, &left);
 #else
-    return active_bounds.insert(itr, { &left, &right });
+    itr = active_bounds.insert(itr, { &left, &right });
 #endif
+    update_bound_positions(active_bounds, pos);
+    return itr;
 }
 
 template <typename T>
@@ -159,15 +232,14 @@ void next_edge_in_bound(bound<T>& bnd, scanbeam_list<T>& scanbeam) {
 
 template <typename T>
 active_bound_list_itr<T> get_maxima_pair(active_bound_list_itr<T> bnd, active_bound_list<T>& active_bounds) {
-    bound_ptr<T> maximum = (*bnd)->maximum_bound;
-    return std::find(active_bounds.begin(), active_bounds.end(), maximum);
+    return find_bound((*bnd)->maximum_bound, active_bounds);
 }
 
-template <typename T>
+template <typename T, typename SubjectFill, typename ClipFill>
 void set_winding_count(active_bound_list_itr<T> bnd_itr,
                        active_bound_list<T>& active_bounds,
-                       fill_type subject_fill_type,
-                       fill_type clip_fill_type) {
+                       SubjectFill subject_fill_type,
+                       ClipFill clip_fill_type) {
 
     auto rev_bnd_itr = active_bound_list_rev_itr<T>(bnd_itr);
     if (rev_bnd_itr == active_bounds.rend()) {
@@ -237,8 +309,8 @@ void set_winding_count(active_bound_list_itr<T> bnd_itr,
     }
 }
 
-template <typename T>
-bool is_contributing(bound<T> const& bnd, clip_type cliptype, fill_type subject_fill_type, fill_type clip_fill_type) {
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
+bool is_contributing(bound<T> const& bnd, Clip cliptype, SubjectFill subject_fill_type, ClipFill clip_fill_type) {
     fill_type pft = subject_fill_type;
     fill_type pft2 = clip_fill_type;
     if (bnd.poly_type != polygon_type_subject) {
@@ -324,15 +396,15 @@ bool is_contributing(bound<T> const& bnd, clip_type cliptype, fill_type subject_
     }
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void insert_lm_left_and_right_bound(bound<T>& left_bound,
                                     bound<T>& right_bound,
                                     active_bound_list<T>& active_bounds,
                                     ring_manager<T>& rings,
                                     scanbeam_list<T>& scanbeam,
-                                    clip_type cliptype,
-                                    fill_type subject_fill_type,
-                                    fill_type clip_fill_type) {
+                                    Clip cliptype,
+                                    SubjectFill subject_fill_type,
+                                    ClipFill clip_fill_type) {
 
     // Both left and right bound
     auto lb_abl_itr = insert_bound_into_ABL(left_bound, right_bound, active_bounds);
@@ -352,16 +424,16 @@ void insert_lm_left_and_right_bound(bound<T>& left_bound,
     }
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void insert_local_minima_into_ABL(T const bot_y,
                                   local_minimum_ptr_list<T> const& minima_sorted,
                                   local_minimum_ptr_list_itr<T>& current_lm,
                                   active_bound_list<T>& active_bounds,
                                   ring_manager<T>& rings,
                                   scanbeam_list<T>& scanbeam,
-                                  clip_type cliptype,
-                                  fill_type subject_fill_type,
-                                  fill_type clip_fill_type) {
+                                  Clip cliptype,
+                                  SubjectFill subject_fill_type,
+                                  ClipFill clip_fill_type) {
     while (current_lm != minima_sorted.end() && bot_y == (*current_lm)->y) {
         initialize_lm<T>(current_lm);
         auto& left_bound = (*current_lm)->left_bound;
@@ -372,16 +444,16 @@ void insert_local_minima_into_ABL(T const bot_y,
     }
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void insert_horizontal_local_minima_into_ABL(T const top_y,
                                              local_minimum_ptr_list<T> const& minima_sorted,
                                              local_minimum_ptr_list_itr<T>& current_lm,
                                              active_bound_list<T>& active_bounds,
                                              ring_manager<T>& rings,
                                              scanbeam_list<T>& scanbeam,
-                                             clip_type cliptype,
-                                             fill_type subject_fill_type,
-                                             fill_type clip_fill_type) {
+                                             Clip cliptype,
+                                             SubjectFill subject_fill_type,
+                                             ClipFill clip_fill_type) {
     while (current_lm != minima_sorted.end() && top_y == (*current_lm)->y && (*current_lm)->minimum_has_horizontal) {
         initialize_lm<T>(current_lm);
         auto& left_bound = (*current_lm)->left_bound;
@@ -19,9 +19,9 @@ namespace wagyu {
 template <typename T>
 struct bound {
 
-    edge_list<T> edges;
-    edge_list_itr<T> current_edge;
-    edge_list_itr<T> next_edge;
+    edge_span<T> edges;
+    edge_ptr<T> current_edge;
+    edge_ptr<T> next_edge;
     mapbox::geometry::point<T> last_point;
     ring_ptr<T> ring;
     bound_ptr<T> maximum_bound; // the bound who's maximum connects with this bound
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+
+/**
+ * A static R-tree packed with sort-tile-recursive over a list of boxes, used to find the boxes
+ * that contain a given box. Items are numbered by their position in the list the index was built
+ * from, and each entry of the tree keeps the lowest item number below it, so that a search can
+ * skip everything at or after a given item.
+ *
+ * Entries are stored level by level in one vector, the leaves first and the root last. The
+ * children of the node at position p of a level are node_size consecutive entries of the level
+ * below.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+struct box_index {
+    using box_vector = std::vector<mapbox::geometry::box<T>, resource_allocator<mapbox::geometry::box<T>>>;
+    using index_vector = std::vector<std::size_t, resource_allocator<std::size_t>>;
+
+    static constexpr std::size_t node_size = 16;
+
+    box_vector boxes;
+    index_vector first_items;
+    index_vector level_ends;
+
+    box_index() : box_index(get_default_resource()) {
+    }
+
+    explicit box_index(memory_resource* resource) : boxes(resource), first_items(resource), level_ends(resource) {
+    }
+};
+
+template <typename T>
+constexpr std::size_t box_index<T>::node_size;
+
+template <typename T>
+void add_to_box(mapbox::geometry::box<T>& b, mapbox::geometry::box<T> const& other) {
+    b.min.x = std::min(b.min.x, other.min.x);
+    b.min.y = std::min(b.min.y, other.min.y);
+    b.max.x = std::max(b.max.x, other.max.x);
+    b.max.y = std::max(b.max.y, other.max.y);
+}
+
+template <typename T, typename Boxes>
+void build_box_index(box_index<T>& index, Boxes const& item_boxes) {
+    using index_vector = typename box_index<T>::index_vector;
+    std::size_t const node_size = box_index<T>::node_size;
+    std::size_t n = item_boxes.size();
+    index.boxes.clear();
+    index.first_items.clear();
+    index.level_ends.clear();
+    if (n == 0) {
+        return;
+    }
+
+    // Sort into vertical slices by the x of the box centers, then each slice by y
+    index_vector order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    auto center_x = [&item_boxes](std::size_t i) { return item_boxes[i].min.x / 2 + item_boxes[i].max.x / 2; };
+    auto center_y = [&item_boxes](std::size_t i) { return item_boxes[i].min.y / 2 + item_boxes[i].max.y / 2; };
+    std::sort(order.begin(), order.end(), [&](std::size_t i1, std::size_t i2) { return center_x(i1) < center_x(i2); });
+    std::size_t leaves = (n + node_size - 1) / node_size;
+    std::size_t slices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+    std::size_t slice_size = slices * node_size;
+    for (std::size_t first = 0; first < n; first += slice_size) {
+        auto begin = order.begin() + static_cast<std::ptrdiff_t>(first);
+        auto end = order.begin() + static_cast<std::ptrdiff_t>(std::min(first + slice_size, n));
+        std::sort(begin, end, [&](std::size_t i1, std::size_t i2) { return center_y(i1) < center_y(i2); });
+    }
+
+    index.boxes.reserve(n + n / (node_size - 1) + 1);
+    index.first_items.reserve(index.boxes.capacity());
+    for (auto i : order) {
+        index.boxes.push_back(item_boxes[i]);
+        index.first_items.push_back(i);
+    }
+    index.level_ends.push_back(n);
+
+    // Pack each level into the one above until a single root is left
+    std::size_t level_begin = 0;
+    std::size_t level_end = n;
+    while (level_end - level_begin > 1) {
+        for (std::size_t first = level_begin; first < level_end; first += node_size) {
+            std::size_t last = std::min(first + node_size, level_end);
+            mapbox::geometry::box<T> b = index.boxes[first];
+            std::size_t first_item = index.first_items[first];
+            for (std::size_t c = first + 1; c < last; ++c) {
+                add_to_box(b, index.boxes[c]);
+                first_item = std::min(first_item, index.first_items[c]);
+            }
+            index.boxes.push_back(b);
+            index.first_items.push_back(first_item);
+        }
+        level_begin = level_end;
+        level_end = index.boxes.size();
+        index.level_ends.push_back(level_end);
+    }
+}
+
+// Calls fn(item) for every item before `limit` whose box contains `b`
+template <typename T, typename Fn>
+void find_boxes_containing(box_index<T> const& index, mapbox::geometry::box<T> const& b, std::size_t limit, Fn fn) {
+    using index_vector = typename box_index<T>::index_vector;
+    std::size_t const node_size = box_index<T>::node_size;
+    if (index.boxes.empty()) {
+        return;
+    }
+    // Pairs of entry position and level
+    index_vector stack;
+    stack.push_back(index.boxes.size() - 1);
+    stack.push_back(index.level_ends.size() - 1);
+    while (!stack.empty()) {
+        std::size_t level = stack.back();
+        stack.pop_back();
+        std::size_t pos = stack.back();
+        stack.pop_back();
+        auto const& node_box = index.boxes[pos];
+        if (index.first_items[pos] >= limit || node_box.min.x > b.min.x || node_box.min.y > b.min.y ||
+            node_box.max.x < b.max.x || node_box.max.y < b.max.y) {
+            continue;
+        }
+        if (level == 0) {
+            fn(index.first_items[pos]);
+            continue;
+        }
+        std::size_t level_begin = level == 1 ? 0 : index.level_ends[level - 2];
+        std::size_t offset = pos - index.level_ends[level - 1];
+        std::size_t first = level_begin + offset * node_size;
+        std::size_t last = std::min(first + node_size, index.level_ends[level - 1]);
+        for (std::size_t c = first; c < last; ++c) {
+            stack.push_back(c);
+            stack.push_back(level - 1);
+        }
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -1,27 +1,36 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
 namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
+// Returns the number of swaps made
+template <typename It, class Compare, class MethodOnSwap>
+std::size_t bubble_sort_pass(It begin, It end, Compare c, MethodOnSwap m) {
+    std::size_t swaps = 0;
+    auto last = end - 1;
+    for (auto itr = begin; itr != last; ++itr) {
+        auto next = std::next(itr);
+        if (!c(*itr, *next)) {
+            m(*itr, *next);
+            std::iter_swap(itr, next);
+            ++swaps;
+        }
+    }
+    return swaps;
+}
+
 template <typename It, class Compare, class MethodOnSwap>
 void bubble_sort(It begin, It end, Compare c, MethodOnSwap m) {
     if (begin == end) {
         return;
     }
-    bool modified = false;
-    auto last = end - 1;
-    do {
-        modified = false;
-        for (auto itr = begin; itr != last; ++itr) {
-            auto next = std::next(itr);
-            if (!c(*itr, *next)) {
-                m(*itr, *next);
-                std::iter_swap(itr, next);
-                modified = true;
-            }
-        }
-    } while (modified);
+    while (bubble_sort_pass(begin, end, c, m) > 0) {
+    }
 }
 } // namespace wagyu
 } // namespace geometry
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iterator>
+
 #include <mapbox/geometry/line_string.hpp>
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/polygon.hpp>
@@ -25,8 +27,12 @@ bool point_2_is_between_point_1_and_point_3(mapbox::geometry::point<T> const& pt
     }
 }
 
-template <typename T1, typename T2>
-bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edge_list<T1>& edges) {
+// The ring can be a linear_ring or any other container of points that can be walked both ways,
+// such as an interleaved_ring
+template <typename T1, typename Ring>
+bool build_edge_list(Ring const& path_geometry, edge_list<T1>& edges) {
+    using point_type = typename Ring::value_type;
+    using T2 = typename point_type::coordinate_type;
 
     if (path_geometry.size() < 3) {
         return false;
@@ -37,8 +43,8 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
 
     auto itr_rev = path_geometry.rbegin();
     auto itr = path_geometry.begin();
-    mapbox::geometry::point<T2> pt1 = *itr_rev;
-    mapbox::geometry::point<T2> pt2 = *itr;
+    point_type pt1 = *itr_rev;
+    point_type pt2 = *itr;
 
     // Find next non repeated point going backwards from
     // end for pt1
@@ -50,10 +56,10 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
         pt1 = *itr_rev;
     }
     ++itr;
-    mapbox::geometry::point<T2> pt3 = *itr;
+    point_type pt3 = *itr;
     auto itr_last = itr_rev.base();
-    mapbox::geometry::point<T2> front_pt;
-    mapbox::geometry::point<T2> back_pt;
+    point_type front_pt;
+    point_type back_pt;
     while (true) {
         if (pt3 == pt2) {
             // Duplicate point advance itr, but do not
@@ -87,9 +93,9 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
                 auto const& back_top = edges.back().top;
                 if (static_cast<T1>(back_pt.x) == back_top.x && static_cast<T1>(back_pt.y) == back_top.y) {
                     auto const& back_bot = edges.back().bot;
-                    pt1 = mapbox::geometry::point<T2>(static_cast<T2>(back_bot.x), static_cast<T2>(back_bot.y));
+                    pt1 = point_type(static_cast<T2>(back_bot.x), static_cast<T2>(back_bot.y));
                 } else {
-                    pt1 = mapbox::geometry::point<T2>(static_cast<T2>(back_top.x), static_cast<T2>(back_top.y));
+                    pt1 = point_type(static_cast<T2>(back_top.x), static_cast<T2>(back_top.y));
                 }
                 back_pt = pt1;
             } else {
@@ -97,7 +103,7 @@ bool build_edge_list(mapbox::geometry::linear_ring<T2> const& path_geometry, edg
                 // ring for new points.
                 while (*itr_rev == pt2) {
                     ++itr_rev;
-                    if ((itr + 1) == itr_rev.base()) {
+                    if (std::next(itr) == itr_rev.base()) {
                         return false;
                     }
                 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/flat_multi_polygon.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
 
@@ -11,7 +17,8 @@ namespace wagyu {
 
 template <typename T1, typename T2>
 void push_ring_to_polygon(mapbox::geometry::polygon<T2>& poly, ring_ptr<T1> r, bool reverse_output) {
-    mapbox::geometry::linear_ring<T2> lr;
+    poly.emplace_back();
+    auto& lr = poly.back();
     lr.reserve(r->size() + 1);
     auto firstPt = r->points;
     auto ptIt = r->points;
@@ -27,7 +34,6 @@ void push_ring_to_polygon(mapbox::geometry::polygon<T2>& poly, ring_ptr<T1> r, b
         } while (ptIt != firstPt);
     }
     lr.emplace_back(firstPt->x, firstPt->y); // close the ring
-    poly.push_back(lr);
 }
 
 template <typename T1, typename T2>
@@ -63,6 +69,220 @@ template <typename T1, typename T2>
 void build_result(mapbox::geometry::multi_polygon<T2>& solution, ring_manager<T1> const& rings, bool reverse_output) {
     build_result_polygons(solution, rings.children, reverse_output);
 }
+
+template <typename T1, typename T2>
+void push_ring_to_flat(flat_multi_polygon<T2>& solution, ring_ptr<T1> r, bool reverse_output) {
+    auto& points = solution.points;
+    auto firstPt = r->points;
+    auto ptIt = r->points;
+    if (reverse_output) {
+        do {
+            points.emplace_back(static_cast<T2>(ptIt->x), static_cast<T2>(ptIt->y));
+            ptIt = ptIt->next;
+        } while (ptIt != firstPt);
+    } else {
+        do {
+            points.emplace_back(static_cast<T2>(ptIt->x), static_cast<T2>(ptIt->y));
+            ptIt = ptIt->prev;
+        } while (ptIt != firstPt);
+    }
+    points.emplace_back(static_cast<T2>(firstPt->x), static_cast<T2>(firstPt->y)); // close the ring
+    solution.ring_offsets.push_back(points.size());
+}
+
+template <typename T1, typename T2>
+void build_result_polygons(flat_multi_polygon<T2>& solution, ring_vector<T1> const& rings, bool reverse_output) {
+    for (auto r : rings) {
+        if (r == nullptr) {
+            continue;
+        }
+        assert(r->points);
+        push_ring_to_flat(solution, r, reverse_output);
+        for (auto c : r->children) {
+            if (c == nullptr) {
+                continue;
+            }
+            assert(c->points);
+            push_ring_to_flat(solution, c, reverse_output);
+        }
+        solution.polygon_offsets.push_back(solution.ring_count());
+        for (auto c : r->children) {
+            if (c == nullptr) {
+                continue;
+            }
+            if (!c->children.empty()) {
+                build_result_polygons(solution, c->children, reverse_output);
+            }
+        }
+    }
+}
+
+template <typename T1, typename T2>
+void build_result(flat_multi_polygon<T2>& solution, ring_manager<T1> const& rings, bool reverse_output) {
+    // Every ring left with points is output, so the ring offsets can be sized once. The points
+    // are appended as the rings are walked, as the size kept by a ring may be out of date once
+    // the topology has been corrected.
+    std::size_t ring_count = 0;
+    for (std::size_t i = 0; i < rings.index; ++i) {
+        if (rings.rings[i].points) {
+            ++ring_count;
+        }
+    }
+    solution.ring_offsets.reserve(solution.ring_offsets.size() + ring_count);
+    build_result_polygons(solution, rings.children, reverse_output);
+}
+
+// Walks the points of a ring in output order, ending with its first point again to close it.
+// The end is found by coming back to the first point rather than from the size kept by the
+// ring, which may be out of date once the topology has been corrected.
+template <typename T>
+struct ring_point_iterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = mapbox::geometry::point<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    point_ptr<T> pt;
+    point_ptr<T> first;
+    bool closed; // pt is the first point again
+    bool reverse_output;
+
+    ring_point_iterator(point_ptr<T> first_, bool reverse_output_)
+        : pt(first_), first(first_), closed(false), reverse_output(reverse_output_) {
+    }
+
+    // The end of any ring
+    ring_point_iterator() : pt(nullptr), first(nullptr), closed(true), reverse_output(false) {
+    }
+
+    value_type operator*() const {
+        return value_type(pt->x, pt->y);
+    }
+
+    ring_point_iterator& operator++() {
+        if (closed) {
+            pt = nullptr;
+            first = nullptr;
+        } else {
+            pt = reverse_output ? pt->next : pt->prev;
+            closed = pt == first;
+        }
+        return *this;
+    }
+
+    ring_point_iterator operator++(int) {
+        ring_point_iterator old = *this;
+        ++(*this);
+        return old;
+    }
+
+    bool operator==(ring_point_iterator const& other) const {
+        return pt == other.pt && closed == other.closed;
+    }
+
+    bool operator!=(ring_point_iterator const& other) const {
+        return !(*this == other);
+    }
+};
+
+template <typename T, typename Visitor>
+void visit_ring(Visitor& visitor, ring_ptr<T> r, bool reverse_output) {
+    visitor.ring(ring_point_iterator<T>(r->points, reverse_output), ring_point_iterator<T>());
+}
+
+template <typename T, typename Visitor>
+bool visit_result_polygons(Visitor& visitor, ring_vector<T> const& rings, bool reverse_output) {
+    for (auto r : rings) {
+        if (r == nullptr) {
+            continue;
+        }
+        assert(r->points);
+        visitor.begin_polygon();
+        visit_ring(visitor, r, reverse_output);
+        for (auto c : r->children) {
+            if (c == nullptr) {
+                continue;
+            }
+            assert(c->points);
+            visit_ring(visitor, c, reverse_output);
+        }
+        if (!visitor.end_polygon()) {
+            return false;
+        }
+        for (auto c : r->children) {
+            if (c == nullptr) {
+                continue;
+            }
+            if (!c->children.empty() && !visit_result_polygons(visitor, c->children, reverse_output)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Whether a visitor is handed the points of rings in reverse. Visitors that need a given
+// winding whatever reverse_rings is set to specialize this.
+template <typename Visitor>
+struct visitor_ring_order {
+    static bool reverse(bool reverse_output) {
+        return reverse_output;
+    }
+};
+
+// Hands the polygons of the result to a visitor straight from the points of the rings, in the
+// same order as build_result, instead of building a container:
+//   visitor.begin_polygon()
+//   visitor.ring(begin, end) with ring_point_iterators, the outer ring first and then its holes
+//   visitor.end_polygon(), returning false to stop before the next polygon
+// Returns false if the visitor stopped.
+template <typename T, typename Visitor>
+bool visit_result(Visitor& visitor, ring_manager<T> const& rings, bool reverse_output) {
+    return visit_result_polygons(visitor, rings.children, visitor_ring_order<Visitor>::reverse(reverse_output));
+}
+
+// Whether the result is built into a container, rather than handed to a visitor
+template <typename Solution>
+struct is_result_container : std::false_type {};
+
+template <typename T>
+struct is_result_container<mapbox::geometry::multi_polygon<T>> : std::true_type {};
+
+template <typename T>
+struct is_result_container<flat_multi_polygon<T>> : std::true_type {};
+
+// Builds a container or visits the result as the solution calls for. Returns false if a
+// visitor stopped.
+template <typename T1, typename Solution>
+bool emit_result(Solution& solution, ring_manager<T1> const& rings, bool reverse_output, std::true_type) {
+    build_result(solution, rings, reverse_output);
+    return true;
+}
+
+template <typename T1, typename Visitor>
+bool emit_result(Visitor& visitor, ring_manager<T1> const& rings, bool reverse_output, std::false_type) {
+    return visit_result(visitor, rings, reverse_output);
+}
+
+// Appends the result of one cluster to the result of a whole operation
+template <typename T>
+void append_result(mapbox::geometry::multi_polygon<T>& solution, mapbox::geometry::multi_polygon<T>& result) {
+    solution.insert(solution.end(), std::make_move_iterator(result.begin()), std::make_move_iterator(result.end()));
+}
+
+template <typename T>
+void append_result(flat_multi_polygon<T>& solution, flat_multi_polygon<T> const& result) {
+    std::size_t point_base = solution.points.size();
+    std::size_t ring_base = solution.ring_count();
+    solution.points.insert(solution.points.end(), result.points.begin(), result.points.end());
+    for (std::size_t i = 1; i < result.ring_offsets.size(); ++i) {
+        solution.ring_offsets.push_back(point_base + result.ring_offsets[i]);
+    }
+    for (std::size_t i = 1; i < result.polygon_offsets.size(); ++i) {
+        solution.polygon_offsets.push_back(ring_base + result.polygon_offsets[i]);
+    }
+}
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
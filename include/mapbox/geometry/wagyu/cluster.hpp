@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/local_minimum.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+#include <mapbox/geometry/wagyu/ring.hpp>
+
+/**
+ * Parts of the input whose bounding boxes are apart can not affect each other, so they can be
+ * clipped on their own and their results put together afterwards. The local minima are grouped
+ * into clusters with a union-find over the boxes of their bounds. The minima of a ring always end
+ * up in the same cluster, as neighbouring minima share a maximum. Boxes less than a unit apart are
+ * joined as well, so that a hot pixel of one cluster can never snap an edge of another.
+ *
+ * Clusters are numbered in the order of their first local minimum, so that the result does not
+ * depend on how the work is spread over threads.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+struct minima_cluster {
+    local_minimum_ptr_list<T> minima;
+    ring_manager<T> manager;
+
+    minima_cluster(minima_cluster const&) = delete;
+    minima_cluster& operator=(minima_cluster const&) = delete;
+
+    explicit minima_cluster(memory_resource* resource) : minima(resource), manager(resource) {
+    }
+};
+
+template <typename T>
+using minima_cluster_list = std::deque<minima_cluster<T>, resource_allocator<minima_cluster<T>>>;
+
+template <typename T>
+struct cluster_box {
+    T min_x;
+    T min_y;
+    T max_x;
+    T max_y;
+};
+
+template <typename T>
+void add_to_cluster_box(cluster_box<T>& box, mapbox::geometry::point<T> const& pt) {
+    box.min_x = std::min(box.min_x, pt.x);
+    box.min_y = std::min(box.min_y, pt.y);
+    box.max_x = std::max(box.max_x, pt.x);
+    box.max_y = std::max(box.max_y, pt.y);
+}
+
+template <typename T>
+cluster_box<T> get_cluster_box(local_minimum<T> const& lm) {
+    auto const& first = lm.left_bound.edges.front().bot;
+    cluster_box<T> box = { first.x, first.y, first.x, first.y };
+    for (auto const& e : lm.left_bound.edges) {
+        add_to_cluster_box(box, e.bot);
+        add_to_cluster_box(box, e.top);
+    }
+    for (auto const& e : lm.right_bound.edges) {
+        add_to_cluster_box(box, e.bot);
+        add_to_cluster_box(box, e.top);
+    }
+    return box;
+}
+
+// True if every value up to `max` is more than a unit below `min`
+template <typename T>
+inline bool values_are_apart(T max, T min) {
+    return max < min && max < min - 1;
+}
+
+template <typename T>
+bool cluster_boxes_are_apart(cluster_box<T> const& b1, cluster_box<T> const& b2) {
+    return values_are_apart(b1.max_x, b2.min_x) || values_are_apart(b2.max_x, b1.min_x) ||
+           values_are_apart(b1.max_y, b2.min_y) || values_are_apart(b2.max_y, b1.min_y);
+}
+
+template <typename Parents>
+std::size_t find_cluster_root(Parents& parents, std::size_t i) {
+    while (parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+// Splits the local minima into clusters that can be processed on their own. Nothing is added to
+// `clusters` if everything is connected.
+template <typename T>
+void build_minima_clusters(local_minimum_list<T>& minima_list,
+                           minima_cluster_list<T>& clusters,
+                           memory_resource* resource) {
+    using index_list = std::vector<std::size_t, resource_allocator<std::size_t>>;
+    std::size_t n = minima_list.size();
+    if (n < 2) {
+        return;
+    }
+    std::vector<cluster_box<T>, resource_allocator<cluster_box<T>>> boxes;
+    boxes.reserve(n);
+    for (auto const& lm : minima_list) {
+        boxes.push_back(get_cluster_box(lm));
+    }
+    index_list parents(n);
+    index_list order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parents[i] = i;
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&boxes](std::size_t i1, std::size_t i2) { return boxes[i1].min_x < boxes[i2].min_x; });
+
+    // Sweep from left to right keeping the clusters that may still touch what comes next,
+    // each with the box around all of its minima. Merged boxes can only grow, so this may
+    // join a few clusters that do not actually touch but never misses any that do.
+    index_list active;
+    std::vector<cluster_box<T>, resource_allocator<cluster_box<T>>> active_boxes(boxes);
+    for (auto i : order) {
+        auto const& box = boxes[i];
+        std::size_t root = i;
+        std::size_t kept = 0;
+        for (std::size_t a = 0; a < active.size(); ++a) {
+            std::size_t other = active[a];
+            auto& other_box = active_boxes[other];
+            if (values_are_apart(other_box.max_x, box.min_x)) {
+                continue;
+            }
+            if (cluster_boxes_are_apart(other_box, active_boxes[root])) {
+                active[kept++] = other;
+                continue;
+            }
+            auto& root_box = active_boxes[root];
+            root_box.min_x = std::min(root_box.min_x, other_box.min_x);
+            root_box.min_y = std::min(root_box.min_y, other_box.min_y);
+            root_box.max_x = std::max(root_box.max_x, other_box.max_x);
+            root_box.max_y = std::max(root_box.max_y, other_box.max_y);
+            parents[other] = root;
+        }
+        active.resize(kept);
+        active.push_back(root);
+    }
+
+    index_list cluster_of_root(n, n);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t root = find_cluster_root(parents, i);
+        if (cluster_of_root[root] == n) {
+            cluster_of_root[root] = count++;
+        }
+    }
+    if (count < 2) {
+        return;
+    }
+    for (std::size_t c = 0; c < count; ++c) {
+        clusters.emplace_back(resource);
+    }
+    std::size_t i = 0;
+    for (auto& lm : minima_list) {
+        clusters[cluster_of_root[find_cluster_root(parents, i++)]].minima.push_back(&lm);
+    }
+    for (auto& cluster : clusters) {
+        std::stable_sort(cluster.minima.begin(), cluster.minima.end(), local_minimum_sorter<T>());
+    }
+}
+
+// Calls fn(i) for every i below count on up to `threads` threads, one of them being the calling
+// thread, with `resource` as the current memory resource. Once a call throws no more are started,
+// and the exception with the lowest index is rethrown when all threads are done.
+template <typename Fn>
+void run_concurrently(std::size_t count, std::size_t threads, memory_resource* resource, Fn fn) {
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::exception_ptr, resource_allocator<std::exception_ptr>> errors(count);
+    auto work = [&]() {
+        memory_resource_scope scope(resource);
+        while (!failed) {
+            std::size_t i = next++;
+            if (i >= count) {
+                break;
+            }
+            try {
+                fn(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    std::vector<std::thread, resource_allocator<std::thread>> workers;
+    std::size_t extra = std::min(threads, count);
+    extra = extra > 0 ? extra - 1 : 0;
+    workers.reserve(extra);
+    for (std::size_t t = 0; t < extra; ++t) {
+        try {
+            workers.emplace_back(work);
+        } catch (std::system_error const&) {
+            // Carry on with the threads we have
+            break;
+        }
+    }
+    work();
+    for (auto& w : workers) {
+        w.join();
+    }
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -4,6 +4,9 @@
 #include <cstdint>
 #include <list>
 #include <stdexcept>
+#include <type_traits>
+
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
 
 // GCC 4.8 missing range std::vector::insert (c++11)
 #ifdef __GNUC__
@@ -22,6 +25,14 @@ enum polygon_type : std::uint8_t { polygon_type_subject = 0, polygon_type_clip }
 
 enum fill_type : std::uint8_t { fill_type_even_odd = 0, fill_type_non_zero, fill_type_positive, fill_type_negative };
 
+// The sweep takes its clip and fill types either as these enums or, for the combinations
+// it is specialized on, as compile time constants so that the checks on them fold away.
+template <clip_type C>
+using clip_type_constant = std::integral_constant<clip_type, C>;
+
+template <fill_type F>
+using fill_type_constant = std::integral_constant<fill_type, F>;
+
 static double const def_arc_tolerance = 0.25;
 
 static int const EDGE_UNASSIGNED = -1; // edge not currently 'owning' a solution
@@ -29,6 +40,18 @@ static int const EDGE_SKIP = -2;       // edge that would otherwise close a path
 static std::int64_t const LOW_RANGE = 0x3FFFFFFF;
 static std::int64_t const HIGH_RANGE = 0x3FFFFFFFFFFFFFFFLL;
 
+// How crossing bounds are found between scanbeams, see crossing_sort.hpp
+enum crossing_sort_type : std::uint8_t { crossing_sort_adaptive = 0, crossing_sort_bubble, crossing_sort_merge };
+
+// Phases of topology correction, as the bits of the mask correct_topology returns
+enum topology_phase : std::uint8_t {
+    topology_phase_orientations = 1,
+    topology_phase_collinear_edges = 2,
+    topology_phase_self_intersections = 4,
+    topology_phase_tree = 8,
+    topology_phase_chained_rings = 16
+};
+
 enum horizontal_direction : std::uint8_t { right_to_left = 0, left_to_right = 1 };
 
 enum edge_side : std::uint8_t { edge_left = 0, edge_right };
@@ -44,7 +67,7 @@ enum end_type {
 };
 
 template <typename T>
-using maxima_list = std::list<T>;
+using maxima_list = std::list<T, resource_allocator<T>>;
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
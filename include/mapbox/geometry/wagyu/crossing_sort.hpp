@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/bubble_sort.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+/**
+ * Sorting the active bound list between scanbeams is how crossing bounds are found: every
+ * swap made by bubble_sort is an intersection. A bubble sort costs O(n) per pass and needs as
+ * many passes as the furthest any bound has to travel, so it degrades to O(n^2) when many
+ * bounds cross in one scanbeam.
+ *
+ * enumerate_inversions finds the same swaps with a merge sort in O((n + k) log n) and then
+ * reports them in the exact order bubble_sort would have. For a pair (a, b) with a before b,
+ * bubble_sort swaps them in pass r, where r is the rank of a among the elements before b that
+ * are greater than b (largest first, ties broken by the later element first), and within a
+ * pass swaps happen in order of the original position of b.
+ *
+ * This only holds if the comparator swaps exactly the pairs whose keys are out of order. The
+ * active bound list comparator never swaps bounds with equal keys, but it also keeps parallel
+ * bounds in place. Every inverted pair is checked against the comparator, and nothing is changed
+ * if any of them disagree so that the caller can fall back to bubble_sort.
+ */
+
+template <typename It, class Key, class Compare, class MethodOnSwap>
+bool enumerate_inversions(It begin, It end, Key k, Compare c, MethodOnSwap m) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using index_pair = std::pair<std::size_t, std::size_t>;
+    std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n < 2) {
+        return true;
+    }
+    std::vector<double, resource_allocator<double>> keys;
+    keys.reserve(n);
+    for (auto itr = begin; itr != end; ++itr) {
+        double key = k(*itr);
+        if (std::isnan(key)) {
+            return false;
+        }
+        keys.push_back(key);
+    }
+
+    // Bottom up stable merge sort of positions, recording every inverted pair as (a, b)
+    std::vector<std::size_t, resource_allocator<std::size_t>> order(n);
+    std::vector<std::size_t, resource_allocator<std::size_t>> buffer(n);
+    std::vector<index_pair, resource_allocator<index_pair>> inversions;
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    for (std::size_t width = 1; width < n; width *= 2) {
+        for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+            std::size_t mid = std::min(lo + width, n);
+            std::size_t hi = std::min(lo + 2 * width, n);
+            std::size_t i = lo;
+            std::size_t j = mid;
+            std::size_t out = lo;
+            while (i < mid && j < hi) {
+                if (keys[order[j]] < keys[order[i]]) {
+                    for (std::size_t l = i; l < mid; ++l) {
+                        inversions.emplace_back(order[l], order[j]);
+                    }
+                    buffer[out++] = order[j++];
+                } else {
+                    buffer[out++] = order[i++];
+                }
+            }
+            while (i < mid) {
+                buffer[out++] = order[i++];
+            }
+            while (j < hi) {
+                buffer[out++] = order[j++];
+            }
+        }
+        order.swap(buffer);
+    }
+    if (inversions.empty()) {
+        return true;
+    }
+    for (auto const& inv : inversions) {
+        if (c(*(begin + static_cast<std::ptrdiff_t>(inv.first)), *(begin + static_cast<std::ptrdiff_t>(inv.second)))) {
+            return false;
+        }
+    }
+
+    // Group the inversions by b, each group in the order b meets them
+    std::vector<std::size_t, resource_allocator<std::size_t>> offsets(n + 1, 0);
+    for (auto const& inv : inversions) {
+        ++offsets[inv.second + 1];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<std::size_t, resource_allocator<std::size_t>> partners(inversions.size());
+    {
+        std::vector<std::size_t, resource_allocator<std::size_t>> fill(offsets.begin(), offsets.end() - 1);
+        for (auto const& inv : inversions) {
+            partners[fill[inv.second]++] = inv.first;
+        }
+    }
+    std::size_t passes = 0;
+    for (std::size_t b = 0; b < n; ++b) {
+        auto first = partners.begin() + static_cast<std::ptrdiff_t>(offsets[b]);
+        auto last = partners.begin() + static_cast<std::ptrdiff_t>(offsets[b + 1]);
+        std::sort(first, last, [&keys](std::size_t a1, std::size_t a2) {
+            if (keys[a1] > keys[a2]) {
+                return true;
+            }
+            if (keys[a2] > keys[a1]) {
+                return false;
+            }
+            return a1 > a2;
+        });
+        passes = std::max(passes, offsets[b + 1] - offsets[b]);
+    }
+
+    // Bucket by pass, b is visited in ascending position so each pass stays in order
+    std::vector<std::size_t, resource_allocator<std::size_t>> pass_offsets(passes + 1, 0);
+    for (std::size_t b = 0; b < n; ++b) {
+        for (std::size_t r = 0; r < offsets[b + 1] - offsets[b]; ++r) {
+            ++pass_offsets[r + 1];
+        }
+    }
+    for (std::size_t p = 0; p < passes; ++p) {
+        pass_offsets[p + 1] += pass_offsets[p];
+    }
+    for (std::size_t b = 0; b < n; ++b) {
+        for (std::size_t r = 0; r < offsets[b + 1] - offsets[b]; ++r) {
+            inversions[pass_offsets[r]++] = index_pair(partners[offsets[b] + r], b);
+        }
+    }
+    for (auto const& inv : inversions) {
+        m(*(begin + static_cast<std::ptrdiff_t>(inv.first)), *(begin + static_cast<std::ptrdiff_t>(inv.second)));
+    }
+
+    std::vector<value_type, resource_allocator<value_type>> sorted;
+    sorted.reserve(n);
+    for (auto i : order) {
+        sorted.push_back(*(begin + static_cast<std::ptrdiff_t>(i)));
+    }
+    std::copy(sorted.begin(), sorted.end(), begin);
+    return true;
+}
+
+// The number of bubble sort passes that cost about as much as the merge sort
+inline std::size_t crossing_sort_pass_budget(std::size_t n) {
+    std::size_t budget = 1;
+    while (n > 1) {
+        n >>= 1;
+        ++budget;
+    }
+    return budget;
+}
+
+template <typename It, class Key, class Compare, class MethodOnSwap>
+void crossing_sort(It begin, It end, Key k, Compare c, MethodOnSwap m, crossing_sort_type method) {
+    if (begin == end) {
+        return;
+    }
+    if (method == crossing_sort_bubble) {
+        bubble_sort(begin, end, c, m);
+        return;
+    }
+    if (method == crossing_sort_adaptive) {
+        // Most scanbeams need only a pass or two. Bubble sort is only slow when it
+        // keeps going with few swaps per pass, which happens when a few bounds
+        // travel a long way to the left. Switch over once that is clear, what is
+        // left of a bubble sort after any number of passes is the same as a
+        // bubble sort of the current order.
+        std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+        std::size_t budget = crossing_sort_pass_budget(n);
+        std::size_t pass = 0;
+        while (true) {
+            std::size_t swaps = bubble_sort_pass(begin, end, c, m);
+            if (swaps == 0) {
+                return;
+            }
+            if (++pass >= budget && swaps * 16 < n) {
+                break;
+            }
+        }
+    }
+    if (!enumerate_inversions(begin, end, k, c, m)) {
+        bubble_sort(begin, end, c, m);
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
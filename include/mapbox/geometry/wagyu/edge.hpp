@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <deque>
+#include <iterator>
 #include <limits>
 #include <list>
 
@@ -61,11 +64,91 @@ template <typename T>
 using edge_ptr = edge<T>*;
 
 template <typename T>
-using edge_list = std::vector<edge<T>>;
+using edge_list = std::vector<edge<T>, resource_allocator<edge<T>>>;
 
 template <typename T>
 using edge_list_itr = typename edge_list<T>::iterator;
 
+// The edges of a single bound, a range of edges in an edge_pool
+template <typename T>
+struct edge_span {
+    edge_ptr<T> first;
+    edge_ptr<T> last;
+
+    edge_span() noexcept : first(nullptr), last(nullptr) {
+    }
+
+    edge_span(edge_ptr<T> first_, edge_ptr<T> last_) noexcept : first(first_), last(last_) {
+    }
+
+    edge_ptr<T> begin() const {
+        return first;
+    }
+
+    edge_ptr<T> end() const {
+        return last;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(last - first);
+    }
+
+    edge<T>& front() const {
+        return *first;
+    }
+
+    edge<T>& back() const {
+        return *(last - 1);
+    }
+};
+
+// Holds the edges of every ring added to a wagyu object in a few large chunks. A ring is
+// built in ring_edges and then moved into a chunk in one piece, so that the bounds made
+// from it are next to each other and never have to be allocated on their own. Chunks are
+// never resized, so spans stay valid until the pool is cleared.
+template <typename T>
+struct edge_pool {
+    using chunk_list = std::deque<edge_list<T>, resource_allocator<edge_list<T>>>;
+
+    chunk_list chunks;
+    edge_list<T> ring_edges;
+
+    edge_pool() : edge_pool(get_default_resource()) {
+    }
+
+    explicit edge_pool(memory_resource* resource) : chunks(resource), ring_edges(resource) {
+    }
+
+    edge_span<T> add(edge_list<T>& edges) {
+        if (chunks.empty() || chunks.back().capacity() - chunks.back().size() < edges.size()) {
+            std::size_t capacity = chunks.empty() ? 256 : std::min(chunks.back().capacity() * 2, std::size_t(65536));
+            chunks.emplace_back(chunks.get_allocator());
+            chunks.back().reserve(std::max(capacity, edges.size()));
+        }
+        auto& chunk = chunks.back();
+        std::size_t offset = chunk.size();
+        std::move(edges.begin(), edges.end(), std::back_inserter(chunk));
+        return edge_span<T>(chunk.data() + offset, chunk.data() + chunk.size());
+    }
+
+    // Makes room for this many more edges in a single chunk
+    void reserve(std::size_t count) {
+        if (chunks.empty() || chunks.back().capacity() - chunks.back().size() < count) {
+            chunks.emplace_back(chunks.get_allocator());
+            chunks.back().reserve(count);
+        }
+    }
+
+    void clear() {
+        chunks.clear();
+        ring_edges.clear();
+    }
+};
+
 template <typename T>
 bool slopes_equal(edge<T> const& e1, edge<T> const& e2) {
     return static_cast<std::int64_t>(e1.top.y - e1.bot.y) * static_cast<std::int64_t>(e2.top.x - e2.bot.x) ==
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <mapbox/geometry/point.hpp>
+
+/**
+ * Polygons laid out as in the GeoArrow polygon encoding, with the points of all rings in a single
+ * array. Ring r is made of points [ring_offsets[r], ring_offsets[r + 1]) and polygon p of rings
+ * [polygon_offsets[p], polygon_offsets[p + 1]), its outer ring first. Rings are closed, repeating
+ * their first point at the end, as they are in a multi_polygon.
+ *
+ * Results are appended, so that the same object can collect the results of several operations.
+ * Calling clear() before reusing it keeps the capacity of the arrays.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+struct flat_multi_polygon {
+    std::vector<mapbox::geometry::point<T>> points;
+    std::vector<std::size_t> ring_offsets;
+    std::vector<std::size_t> polygon_offsets;
+
+    flat_multi_polygon() : points(), ring_offsets(1, 0), polygon_offsets(1, 0) {
+    }
+
+    void clear() {
+        points.clear();
+        ring_offsets.assign(1, 0);
+        polygon_offsets.assign(1, 0);
+    }
+
+    bool empty() const {
+        return polygon_offsets.size() < 2;
+    }
+
+    std::size_t polygon_count() const {
+        return polygon_offsets.size() - 1;
+    }
+
+    std::size_t ring_count() const {
+        return ring_offsets.size() - 1;
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <mapbox/geometry/point.hpp>
+
+/**
+ * A ring read in place from coordinates stored as x, y pairs one after another, as decoded tile
+ * geometries often are, so that it can be added without copying it into a linear_ring first.
+ * build_edge_list only walks a ring back and forth, which is all the view provides.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename T>
+struct interleaved_point_iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = mapbox::geometry::point<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    T const* xy;
+
+    explicit interleaved_point_iterator(T const* xy_) : xy(xy_) {
+    }
+
+    value_type operator*() const {
+        return value_type(xy[0], xy[1]);
+    }
+
+    interleaved_point_iterator& operator++() {
+        xy += 2;
+        return *this;
+    }
+
+    interleaved_point_iterator operator++(int) {
+        interleaved_point_iterator old = *this;
+        xy += 2;
+        return old;
+    }
+
+    interleaved_point_iterator& operator--() {
+        xy -= 2;
+        return *this;
+    }
+
+    interleaved_point_iterator operator--(int) {
+        interleaved_point_iterator old = *this;
+        xy -= 2;
+        return old;
+    }
+
+    bool operator==(interleaved_point_iterator const& other) const {
+        return xy == other.xy;
+    }
+
+    bool operator!=(interleaved_point_iterator const& other) const {
+        return xy != other.xy;
+    }
+};
+
+template <typename T>
+struct interleaved_ring {
+    using value_type = mapbox::geometry::point<T>;
+    using const_iterator = interleaved_point_iterator<T>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    T const* xy;
+    std::size_t count; // number of points, half the number of coordinates
+
+    interleaved_ring(T const* xy_, std::size_t count_) : xy(xy_), count(count_) {
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    const_iterator begin() const {
+        return const_iterator(xy);
+    }
+
+    const_iterator end() const {
+        return const_iterator(xy + 2 * count);
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
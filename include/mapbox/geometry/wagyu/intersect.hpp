@@ -38,7 +38,7 @@ struct intersect_node {
 };
 
 template <typename T>
-using intersect_list = std::vector<intersect_node<T>>;
+using intersect_list = std::vector<intersect_node<T>, resource_allocator<intersect_node<T>>>;
 
 #ifdef DEBUG
 
@@ -2,13 +2,14 @@
 
 #include <mapbox/geometry/wagyu/active_bound_list.hpp>
 #include <mapbox/geometry/wagyu/bound.hpp>
-#include <mapbox/geometry/wagyu/bubble_sort.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/crossing_sort.hpp>
 #include <mapbox/geometry/wagyu/intersect.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 #include <algorithm>
+#include <limits>
 
 namespace mapbox {
 namespace geometry {
@@ -81,6 +82,13 @@ struct intersection_compare {
     }
 };
 
+template <typename T>
+struct bound_current_x {
+    double operator()(bound_ptr<T> const& b) const {
+        return b->current_x;
+    }
+};
+
 template <typename T>
 struct on_intersection_swap {
 
@@ -101,18 +109,20 @@ struct on_intersection_swap {
 };
 
 template <typename T>
-void build_intersect_list(active_bound_list<T>& active_bounds, intersect_list<T>& intersects) {
-    bubble_sort(active_bounds.begin(), active_bounds.end(), intersection_compare<T>(),
-                on_intersection_swap<T>(intersects));
+void build_intersect_list(active_bound_list<T>& active_bounds,
+                          intersect_list<T>& intersects,
+                          crossing_sort_type method = crossing_sort_adaptive) {
+    crossing_sort(active_bounds.begin(), active_bounds.end(), bound_current_x<T>(), intersection_compare<T>(),
+                  on_intersection_swap<T>(intersects), method);
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void intersect_bounds(bound<T>& b1,
                       bound<T>& b2,
                       mapbox::geometry::point<T> const& pt,
-                      clip_type cliptype,
-                      fill_type subject_fill_type,
-                      fill_type clip_fill_type,
+                      Clip cliptype,
+                      SubjectFill subject_fill_type,
+                      ClipFill clip_fill_type,
                       ring_manager<T>& rings,
                       active_bound_list<T>& active_bounds) {
     bool b1Contributing = (b1.ring != nullptr);
@@ -278,32 +288,26 @@ bool bounds_adjacent(intersect_node<T> const& inode, bound_ptr<T> next) {
 }
 
 template <typename T>
-struct find_first_bound {
-    bound_ptr<T> b1;
-    bound_ptr<T> b2;
-
-    find_first_bound(intersect_node<T> const& inode) : b1(inode.bound1), b2(inode.bound2) {
-    }
-
-    bool operator()(bound_ptr<T> const& b) {
-        return b == b1 || b == b2;
-    }
-};
+active_bound_list_itr<T> find_first_bound(intersect_node<T> const& inode, active_bound_list<T>& active_bounds) {
+    auto b1 = find_bound(inode.bound1, active_bounds);
+    auto b2 = find_bound(inode.bound2, active_bounds);
+    return b1 < b2 ? b1 : b2;
+}
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void process_intersect_list(intersect_list<T>& intersects,
-                            clip_type cliptype,
-                            fill_type subject_fill_type,
-                            fill_type clip_fill_type,
+                            Clip cliptype,
+                            SubjectFill subject_fill_type,
+                            ClipFill clip_fill_type,
                             ring_manager<T>& rings,
                             active_bound_list<T>& active_bounds) {
     for (auto node_itr = intersects.begin(); node_itr != intersects.end(); ++node_itr) {
-        auto b1 = std::find_if(active_bounds.begin(), active_bounds.end(), find_first_bound<T>(*node_itr));
+        auto b1 = find_first_bound(*node_itr, active_bounds);
         auto b2 = std::next(b1);
         if (!bounds_adjacent(*node_itr, *b2)) {
             auto next_itr = std::next(node_itr);
             while (next_itr != intersects.end()) {
-                auto n1 = std::find_if(active_bounds.begin(), active_bounds.end(), find_first_bound<T>(*next_itr));
+                auto n1 = find_first_bound(*next_itr, active_bounds);
                 auto n2 = std::next(n1);
                 if (bounds_adjacent(*next_itr, *n2)) {
                     b1 = n1;
@@ -320,32 +324,42 @@ void process_intersect_list(intersect_list<T>& intersects,
         mapbox::geometry::point<T> pt = round_point<T>(node_itr->pt);
         intersect_bounds(*(node_itr->bound1), *(node_itr->bound2), pt, cliptype, subject_fill_type, clip_fill_type,
                          rings, active_bounds);
-        std::iter_swap(b1, b2);
+        swap_bounds<T>(b1, b2, active_bounds);
     }
 }
 
+// Moves the bounds to top_y and returns whether any neighbours are now out of order. When none
+// are, sorting the list would not swap anything and there are no intersections to find.
 template <typename T>
-void update_current_x(active_bound_list<T>& active_bounds, T top_y) {
+bool update_current_x(active_bound_list<T>& active_bounds, T top_y) {
     std::size_t pos = 0;
+    bool out_of_order = false;
+    double prev_x = -std::numeric_limits<double>::infinity();
     for (auto& bnd : active_bounds) {
         bnd->pos = pos++;
-        bnd->current_x = get_current_x(*bnd->current_edge, top_y);
+        double x = get_current_x(*bnd->current_edge, top_y);
+        bnd->current_x = x;
+        out_of_order = out_of_order || prev_x > x;
+        prev_x = x;
     }
+    return out_of_order;
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void process_intersections(T top_y,
                            active_bound_list<T>& active_bounds,
-                           clip_type cliptype,
-                           fill_type subject_fill_type,
-                           fill_type clip_fill_type,
+                           Clip cliptype,
+                           SubjectFill subject_fill_type,
+                           ClipFill clip_fill_type,
                            ring_manager<T>& rings) {
     if (active_bounds.empty()) {
         return;
     }
-    update_current_x(active_bounds, top_y);
+    if (!update_current_x(active_bounds, top_y)) {
+        return;
+    }
     intersect_list<T> intersects;
-    build_intersect_list(active_bounds, intersects);
+    build_intersect_list(active_bounds, intersects, rings.crossing_method);
 
     if (intersects.empty()) {
         return;
@@ -5,6 +5,8 @@
 #include <sstream>
 #endif
 
+#include <algorithm>
+#include <deque>
 #include <queue>
 
 #include <mapbox/geometry/wagyu/bound.hpp>
@@ -28,17 +30,11 @@ struct local_minimum {
     }
 };
 
-template <typename T>
-using local_minimum_list = std::deque<local_minimum<T>>;
-
-template <typename T>
-using local_minimum_itr = typename local_minimum_list<T>::iterator;
-
 template <typename T>
 using local_minimum_ptr = local_minimum<T>*;
 
 template <typename T>
-using local_minimum_ptr_list = std::vector<local_minimum_ptr<T>>;
+using local_minimum_ptr_list = std::vector<local_minimum_ptr<T>, resource_allocator<local_minimum_ptr<T>>>;
 
 template <typename T>
 using local_minimum_ptr_list_itr = typename local_minimum_ptr_list<T>::iterator;
@@ -54,6 +50,48 @@ struct local_minimum_sorter {
     }
 };
 
+// The local minima of all added rings, along with the pool their bounds' edges are kept in
+template <typename T>
+struct local_minimum_list : public std::deque<local_minimum<T>, resource_allocator<local_minimum<T>>> {
+    using base = std::deque<local_minimum<T>, resource_allocator<local_minimum<T>>>;
+
+    edge_pool<T> edge_storage;
+    local_minimum_ptr_list<T> sorted;
+
+    local_minimum_list() : local_minimum_list(get_default_resource()) {
+    }
+
+    explicit local_minimum_list(memory_resource* resource)
+        : base(resource_allocator<local_minimum<T>>(resource)), edge_storage(resource), sorted(resource) {
+    }
+
+    void clear() {
+        base::clear();
+        edge_storage.clear();
+        sorted.clear();
+    }
+};
+
+template <typename T>
+using local_minimum_itr = typename local_minimum_list<T>::iterator;
+
+// Minima are only ever appended or cleared, so the sorted list is still good as long as it
+// has as many entries as there are minima.
+template <typename T>
+local_minimum_ptr_list<T>& sort_local_minima(local_minimum_list<T>& minima_list) {
+    auto& minima_sorted = minima_list.sorted;
+    if (minima_sorted.size() == minima_list.size()) {
+        return minima_sorted;
+    }
+    minima_sorted.clear();
+    minima_sorted.reserve(minima_list.size());
+    for (auto& lm : minima_list) {
+        minima_sorted.push_back(&lm);
+    }
+    std::stable_sort(minima_sorted.begin(), minima_sorted.end(), local_minimum_sorter<T>());
+    return minima_sorted;
+}
+
 #ifdef DEBUG
 
 template <class charT, class traits, typename T>
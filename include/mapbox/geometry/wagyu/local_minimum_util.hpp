@@ -58,13 +58,14 @@ void start_list_on_local_maximum(edge_list<T>& edges) {
 }
 
 template <typename T>
-bound<T> create_bound_towards_minimum(edge_list<T>& edges) {
+bound<T> create_bound_towards_minimum(edge_span<T>& edges) {
     if (edges.size() == 1) {
         if (is_horizontal(edges.front())) {
             reverse_horizontal(edges.front());
         }
         bound<T> bnd;
-        std::swap(bnd.edges, edges);
+        bnd.edges = edges;
+        edges.first = edges.last;
         return bnd;
     }
     auto next_edge = edges.begin();
@@ -98,22 +99,18 @@ bound<T> create_bound_towards_minimum(edge_list<T>& edges) {
         ++next_edge;
     }
     bound<T> bnd;
-    if (next_edge == edges.end()) {
-        std::swap(edges, bnd.edges);
-    } else {
-        bnd.edges.reserve(static_cast<std::size_t>(std::distance(edges.begin(), next_edge)));
-        std::move(edges.begin(), next_edge, std::back_inserter(bnd.edges));
-        edges.erase(edges.begin(), next_edge);
-    }
+    bnd.edges = edge_span<T>(edges.begin(), next_edge);
+    edges.first = next_edge;
     std::reverse(bnd.edges.begin(), bnd.edges.end());
     return bnd;
 }
 
 template <typename T>
-bound<T> create_bound_towards_maximum(edge_list<T>& edges) {
+bound<T> create_bound_towards_maximum(edge_span<T>& edges) {
     if (edges.size() == 1) {
         bound<T> bnd;
-        std::swap(bnd.edges, edges);
+        bnd.edges = edges;
+        edges.first = edges.last;
         return bnd;
     }
     auto next_edge = edges.begin();
@@ -141,13 +138,8 @@ bound<T> create_bound_towards_maximum(edge_list<T>& edges) {
         ++next_edge;
     }
     bound<T> bnd;
-    if (next_edge == edges.end()) {
-        std::swap(bnd.edges, edges);
-    } else {
-        bnd.edges.reserve(static_cast<std::size_t>(std::distance(edges.begin(), next_edge)));
-        std::move(edges.begin(), next_edge, std::back_inserter(bnd.edges));
-        edges.erase(edges.begin(), next_edge);
-    }
+    bnd.edges = edge_span<T>(edges.begin(), next_edge);
+    edges.first = next_edge;
     return bnd;
 }
 
@@ -188,10 +180,19 @@ void move_horizontals_on_left_to_right(bound<T>& left_bound, bound<T>& right_bou
         return;
     }
     std::reverse(left_bound.edges.begin(), edge_itr);
-    auto dist = std::distance(left_bound.edges.begin(), edge_itr);
-    std::move(left_bound.edges.begin(), edge_itr, std::back_inserter(right_bound.edges));
-    left_bound.edges.erase(left_bound.edges.begin(), edge_itr);
-    std::rotate(right_bound.edges.begin(), std::prev(right_bound.edges.end(), dist), right_bound.edges.end());
+    // Both bounds were cut from the same ring and are next to each other in the edge pool,
+    // so the horizontals are moved to the front of the right bound by rotating them into place.
+    if (left_bound.edges.end() == right_bound.edges.begin()) {
+        std::rotate(left_bound.edges.begin(), edge_itr, left_bound.edges.end());
+        auto dist = std::distance(left_bound.edges.begin(), edge_itr);
+        left_bound.edges.last -= dist;
+        right_bound.edges.first -= dist;
+    } else {
+        assert(right_bound.edges.end() == left_bound.edges.begin());
+        std::rotate(right_bound.edges.begin(), left_bound.edges.begin(), edge_itr);
+        right_bound.edges.last = edge_itr;
+        left_bound.edges.first = edge_itr;
+    }
 }
 
 template <typename T>
@@ -203,17 +204,18 @@ void add_ring_to_local_minima_list(edge_list<T>& edges, local_minimum_list<T>& m
     // Adjust the order of the ring so we start on a local maximum
     // therefore we start right away on a bound.
     start_list_on_local_maximum(edges);
+    edge_span<T> remaining = minima_list.edge_storage.add(edges);
 
     bound_ptr<T> first_minimum = nullptr;
     bound_ptr<T> last_maximum = nullptr;
-    while (!edges.empty()) {
+    while (!remaining.empty()) {
         interrupt_check(); // Check for interruptions
         bool lm_minimum_has_horizontal = false;
-        auto to_minimum = create_bound_towards_minimum(edges);
-        if (edges.empty()) {
+        auto to_minimum = create_bound_towards_minimum(remaining);
+        if (remaining.empty()) {
             throw std::runtime_error("Edges is empty after only creating a single bound.");
         }
-        auto to_maximum = create_bound_towards_maximum(edges);
+        auto to_maximum = create_bound_towards_maximum(remaining);
         fix_horizontals(to_minimum);
         fix_horizontals(to_maximum);
         auto to_max_first_non_horizontal = to_maximum.edges.begin();
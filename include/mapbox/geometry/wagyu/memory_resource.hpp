@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+/**
+ * All containers used internally by wagyu allocate through a `resource_allocator`
+ * which forwards to a `memory_resource`. The interface follows `std::pmr::memory_resource`
+ * so that existing resources can be adapted with a thin wrapper.
+ *
+ * A wagyu object is bound to one memory resource for its entire life, pass it to the
+ * constructor: `wagyu<T> w(&resource);`. Containers that are created while wagyu is working
+ * pick up the resource that is current for the calling thread, which wagyu sets for the
+ * duration of each call with `memory_resource_scope`.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+class memory_resource {
+public:
+    virtual ~memory_resource() = default;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        do_deallocate(p, bytes, alignment);
+    }
+
+    bool is_equal(memory_resource const& other) const noexcept {
+        return do_is_equal(other);
+    }
+
+private:
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+    virtual bool do_is_equal(memory_resource const& other) const noexcept {
+        return this == &other;
+    }
+};
+
+class new_delete_memory_resource : public memory_resource {
+private:
+    void* do_allocate(std::size_t bytes, std::size_t) override {
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, std::size_t, std::size_t) override {
+        ::operator delete(p);
+    }
+};
+
+inline memory_resource* new_delete_resource() noexcept {
+    static new_delete_memory_resource resource;
+    return &resource;
+}
+
+inline memory_resource*& current_resource() noexcept {
+    static thread_local memory_resource* resource = new_delete_resource();
+    return resource;
+}
+
+inline memory_resource* get_default_resource() noexcept {
+    return current_resource();
+}
+
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    memory_resource* previous = current_resource();
+    current_resource() = r == nullptr ? new_delete_resource() : r;
+    return previous;
+}
+
+// Makes a resource the default for the calling thread until the scope ends
+class memory_resource_scope {
+private:
+    memory_resource* previous;
+
+public:
+    memory_resource_scope(memory_resource_scope const&) = delete;
+    memory_resource_scope& operator=(memory_resource_scope const&) = delete;
+
+    explicit memory_resource_scope(memory_resource* r) : previous(set_default_resource(r)) {
+    }
+
+    ~memory_resource_scope() {
+        set_default_resource(previous);
+    }
+};
+
+/**
+ * A bump allocator that never frees individual allocations, all memory is returned
+ * at once by `release()` or when the resource is destroyed. If `max_bytes` is not zero
+ * the resource throws `std::bad_alloc` once it would need more memory from upstream than
+ * that, which can be used to bound the memory of a single job.
+ *
+ * The resource must outlive any wagyu object that uses it.
+ */
+class monotonic_buffer_resource : public memory_resource {
+private:
+    struct chunk {
+        chunk* next;
+        std::size_t size;
+    };
+
+    memory_resource* upstream;
+    chunk* chunks;
+    unsigned char* current;
+    std::size_t space;
+    std::size_t next_size;
+    std::size_t max_bytes;
+    std::size_t bytes_reserved;
+
+    static std::size_t header_size() {
+        return (sizeof(chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+        if (current == nullptr || padding + bytes > space) {
+            std::size_t size = std::max(next_size, bytes + alignment);
+            std::size_t total = header_size() + size;
+            if (max_bytes != 0 && bytes_reserved + total > max_bytes) {
+                throw std::bad_alloc();
+            }
+            chunk* c = static_cast<chunk*>(upstream->allocate(total));
+            c->next = chunks;
+            c->size = total;
+            chunks = c;
+            bytes_reserved += total;
+            current = reinterpret_cast<unsigned char*>(c) + header_size();
+            space = size;
+            next_size = size * 2;
+            padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+        }
+        void* result = current + padding;
+        current += padding + bytes;
+        space -= padding + bytes;
+        return result;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {
+    }
+
+public:
+    monotonic_buffer_resource(monotonic_buffer_resource const&) = delete;
+    monotonic_buffer_resource& operator=(monotonic_buffer_resource const&) = delete;
+
+    explicit monotonic_buffer_resource(std::size_t initial_size = 4096,
+                                       std::size_t max_bytes_ = 0,
+                                       memory_resource* upstream_ = new_delete_resource())
+        : upstream(upstream_),
+          chunks(nullptr),
+          current(nullptr),
+          space(0),
+          next_size(initial_size == 0 ? 1 : initial_size),
+          max_bytes(max_bytes_),
+          bytes_reserved(0) {
+    }
+
+    ~monotonic_buffer_resource() override {
+        release();
+    }
+
+    void release() {
+        while (chunks != nullptr) {
+            chunk* c = chunks;
+            chunks = c->next;
+            upstream->deallocate(c, c->size);
+        }
+        current = nullptr;
+        space = 0;
+        bytes_reserved = 0;
+    }
+
+    // Total memory obtained from upstream, including chunk overhead
+    std::size_t bytes_used() const {
+        return bytes_reserved;
+    }
+};
+
+template <typename U>
+class resource_allocator {
+private:
+    memory_resource* resource_;
+
+    template <typename V>
+    friend class resource_allocator;
+
+public:
+    using value_type = U;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    resource_allocator() noexcept : resource_(get_default_resource()) {
+    }
+
+    resource_allocator(memory_resource* r) noexcept : resource_(r == nullptr ? get_default_resource() : r) {
+    }
+
+    resource_allocator(resource_allocator const& other) noexcept = default;
+    resource_allocator& operator=(resource_allocator const& other) noexcept = default;
+
+    template <typename V>
+    resource_allocator(resource_allocator<V> const& other) noexcept : resource_(other.resource_) {
+    }
+
+    U* allocate(std::size_t n) {
+        return static_cast<U*>(resource_->allocate(n * sizeof(U), alignof(U)));
+    }
+
+    void deallocate(U* p, std::size_t n) noexcept {
+        resource_->deallocate(p, n * sizeof(U), alignof(U));
+    }
+
+    memory_resource* resource() const noexcept {
+        return resource_;
+    }
+};
+
+template <typename U, typename V>
+bool operator==(resource_allocator<U> const& lhs, resource_allocator<V> const& rhs) noexcept {
+    return lhs.resource() == rhs.resource() || lhs.resource()->is_equal(*rhs.resource());
+}
+
+template <typename U, typename V>
+bool operator!=(resource_allocator<U> const& lhs, resource_allocator<V> const& rhs) noexcept {
+    return !(lhs == rhs);
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/build_result.hpp>
+
+/**
+ * Encodes the result of an operation as the geometry of a Mapbox Vector Tile polygon feature,
+ * straight from the points of the rings. It is a visitor for wagyu::execute and visit_result.
+ *
+ * Each ring becomes a MoveTo of its first point, a LineTo of the others and a ClosePath, with the
+ * closing point left out. Points are zigzag encoded deltas from the point before, starting from
+ * the origin for the first ring of the feature. Outer rings must have a positive area and holes a
+ * negative area in tile coordinates. That is the default order of wagyu, and the encoder asks
+ * for it through visitor_ring_order whether or not reverse_rings is set. Coordinates and the
+ * deltas between them have to fit in 32 bits, or a std::runtime_error is thrown.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+enum mvt_command_id : std::uint32_t { mvt_command_move_to = 1, mvt_command_line_to = 2, mvt_command_close_path = 7 };
+
+inline std::uint32_t mvt_command(mvt_command_id id, std::size_t count) {
+    return static_cast<std::uint32_t>(id) | (static_cast<std::uint32_t>(count) << 3);
+}
+
+inline std::uint32_t mvt_zigzag(std::int32_t value) {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+template <typename T>
+struct mvt_geometry_encoder {
+    std::vector<std::uint32_t>& commands;
+    std::int64_t cursor_x;
+    std::int64_t cursor_y;
+
+    // Commands are appended to the buffer
+    explicit mvt_geometry_encoder(std::vector<std::uint32_t>& commands_)
+        : commands(commands_), cursor_x(0), cursor_y(0) {
+    }
+
+    void begin_polygon() {
+    }
+
+    void ring(ring_point_iterator<T> begin, ring_point_iterator<T> end) {
+        commands.push_back(mvt_command(mvt_command_move_to, 1));
+        push_point(*begin);
+        // The number of points is only known once the ring has been walked
+        std::size_t line_to = commands.size();
+        commands.push_back(0);
+        std::size_t count = 0;
+        ++begin;
+        for (ring_point_iterator<T> next = begin; begin != end; begin = next) {
+            if (++next == end) {
+                break; // the closing point
+            }
+            push_point(*begin);
+            ++count;
+        }
+        commands[line_to] = mvt_command(mvt_command_line_to, count);
+        commands.push_back(mvt_command(mvt_command_close_path, 1));
+    }
+
+    bool end_polygon() {
+        return true;
+    }
+
+    void push_point(mapbox::geometry::point<T> const& pt) {
+        std::int64_t x = static_cast<std::int64_t>(pt.x);
+        std::int64_t y = static_cast<std::int64_t>(pt.y);
+        if (!fits_command(x) || !fits_command(y) || !fits_command(x - cursor_x) || !fits_command(y - cursor_y)) {
+            throw std::runtime_error("Point does not fit in a vector tile geometry command");
+        }
+        commands.push_back(mvt_zigzag(static_cast<std::int32_t>(x - cursor_x)));
+        commands.push_back(mvt_zigzag(static_cast<std::int32_t>(y - cursor_y)));
+        cursor_x = x;
+        cursor_y = y;
+    }
+
+    static bool fits_command(std::int64_t value) {
+        return value >= std::numeric_limits<std::int32_t>::min() && value <= std::numeric_limits<std::int32_t>::max();
+    }
+};
+
+template <typename T>
+struct visitor_ring_order<mvt_geometry_encoder<T>> {
+    static bool reverse(bool) {
+        return false;
+    }
+};
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
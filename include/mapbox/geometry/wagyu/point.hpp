@@ -1,6 +1,8 @@
 #pragma once
 
 #include <mapbox/geometry/point.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+#include <mapbox/geometry/wagyu/pool_ptr.hpp>
 
 #ifdef DEBUG
 #include <iostream>
@@ -14,13 +16,29 @@ template <typename T>
 struct point;
 
 template <typename T>
-using point_ptr = point<T>*;
+struct ring;
+
+#ifdef USE_WAGYU_COMPACT_LINKS
 
 template <typename T>
-using const_point_ptr = point<T>* const;
+using point_ptr = pool_ptr<point<T>>;
 
 template <typename T>
-struct ring;
+using const_point_ptr = pool_ptr<point<T>> const;
+
+template <typename T>
+using ring_ptr = pool_ptr<ring<T>>;
+
+template <typename T>
+using const_ring_ptr = pool_ptr<ring<T>> const;
+
+#else
+
+template <typename T>
+using point_ptr = point<T>*;
+
+template <typename T>
+using const_point_ptr = point<T>* const;
 
 template <typename T>
 using ring_ptr = ring<T>*;
@@ -28,6 +46,8 @@ using ring_ptr = ring<T>*;
 template <typename T>
 using const_ring_ptr = ring<T>* const;
 
+#endif
+
 template <typename T>
 struct point {
     using coordinate_type = T;
@@ -55,7 +75,7 @@ struct point {
 };
 
 template <typename T>
-using point_vector = std::vector<point_ptr<T>>;
+using point_vector = std::vector<point_ptr<T>, resource_allocator<point_ptr<T>>>;
 
 template <typename T>
 using point_vector_itr = typename point_vector<T>::iterator;
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#ifdef DEBUG
+#include <iostream>
+#endif
+
+/**
+ * A 32 bit handle to an object that lives in a contiguous pool. It is used in place of
+ * raw pointers for points and rings when USE_WAGYU_COMPACT_LINKS is defined before including
+ * wagyu.hpp. This shrinks `point<T>` from 40 to 32 bytes for 64 bit coordinates and from 32 to
+ * 20 bytes for 32 bit coordinates, at the cost of one extra addition per dereference.
+ *
+ * The pool an object type lives in is found through a thread local base pointer, which the
+ * ring manager updates every time its storage is (re)allocated. An index of 0 is the null
+ * handle, all others are offset by 1.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+template <typename U>
+class pool_ptr {
+private:
+    std::uint32_t index_;
+
+public:
+    static U*& base() noexcept {
+        static thread_local U* data = nullptr;
+        return data;
+    }
+
+    pool_ptr() noexcept : index_(0) {
+    }
+
+    pool_ptr(std::nullptr_t) noexcept : index_(0) {
+    }
+
+    // The object must be a member of the current pool
+    pool_ptr(U* p) noexcept : index_(p == nullptr ? 0 : static_cast<std::uint32_t>(p - base()) + 1) {
+    }
+
+    U* get() const noexcept {
+        return index_ == 0 ? nullptr : base() + (index_ - 1);
+    }
+
+    U* operator->() const noexcept {
+        return base() + (index_ - 1);
+    }
+
+    U& operator*() const noexcept {
+        return *(base() + (index_ - 1));
+    }
+
+    explicit operator bool() const noexcept {
+        return index_ != 0;
+    }
+
+    std::uint32_t index() const noexcept {
+        return index_;
+    }
+};
+
+template <typename U>
+inline bool operator==(pool_ptr<U> const& lhs, pool_ptr<U> const& rhs) noexcept {
+    return lhs.index() == rhs.index();
+}
+
+template <typename U>
+inline bool operator!=(pool_ptr<U> const& lhs, pool_ptr<U> const& rhs) noexcept {
+    return lhs.index() != rhs.index();
+}
+
+template <typename U>
+inline bool operator<(pool_ptr<U> const& lhs, pool_ptr<U> const& rhs) noexcept {
+    return lhs.index() < rhs.index();
+}
+
+template <typename U>
+inline bool operator==(pool_ptr<U> const& lhs, std::nullptr_t) noexcept {
+    return lhs.index() == 0;
+}
+
+template <typename U>
+inline bool operator==(std::nullptr_t, pool_ptr<U> const& rhs) noexcept {
+    return rhs.index() == 0;
+}
+
+template <typename U>
+inline bool operator!=(pool_ptr<U> const& lhs, std::nullptr_t) noexcept {
+    return lhs.index() != 0;
+}
+
+template <typename U>
+inline bool operator!=(std::nullptr_t, pool_ptr<U> const& rhs) noexcept {
+    return rhs.index() != 0;
+}
+
+#ifdef DEBUG
+
+template <class charT, class traits, typename U>
+inline std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& out, pool_ptr<U> const& p) {
+    out << "#" << p.index();
+    return out;
+}
+
+#endif
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
+
+namespace std {
+
+template <typename U>
+struct hash<mapbox::geometry::wagyu::pool_ptr<U>> {
+    std::size_t operator()(mapbox::geometry::wagyu::pool_ptr<U> const& p) const noexcept {
+        return static_cast<std::size_t>(p.index());
+    }
+};
+} // namespace std
@@ -13,15 +13,15 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
                                                           active_bound_list_itr<T>& horz_bound,
                                                           active_bound_list<T>& active_bounds,
                                                           ring_manager<T>& rings,
                                                           scanbeam_list<T>& scanbeam,
-                                                          clip_type cliptype,
-                                                          fill_type subject_fill_type,
-                                                          fill_type clip_fill_type) {
+                                                          Clip cliptype,
+                                                          SubjectFill subject_fill_type,
+                                                          ClipFill clip_fill_type) {
     auto horizontal_itr_behind = horz_bound;
     bool shifted = false;
     bool is_maxima_edge = is_maxima(horz_bound, scanline_y);
@@ -89,7 +89,7 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
 
         intersect_bounds(*(*horz_bound), *(*bnd), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
                          cliptype, subject_fill_type, clip_fill_type, rings, active_bounds);
-        std::iter_swap(horz_bound, bnd);
+        swap_bounds<T>(horz_bound, bnd, active_bounds);
         horz_bound = bnd;
         ++bnd;
         shifted = true;
@@ -118,15 +118,15 @@ active_bound_list_itr<T> process_horizontal_left_to_right(T scanline_y,
     return horizontal_itr_behind;
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
                                                           active_bound_list_itr<T>& horz_bound_fwd,
                                                           active_bound_list<T>& active_bounds,
                                                           ring_manager<T>& rings,
                                                           scanbeam_list<T>& scanbeam,
-                                                          clip_type cliptype,
-                                                          fill_type subject_fill_type,
-                                                          fill_type clip_fill_type) {
+                                                          Clip cliptype,
+                                                          SubjectFill subject_fill_type,
+                                                          ClipFill clip_fill_type) {
     auto next_bnd_itr = std::next(horz_bound_fwd);
     bool is_maxima_edge = is_maxima(horz_bound_fwd, scanline_y);
     auto bound_max_pair = active_bounds.rend();
@@ -191,7 +191,7 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
 
         intersect_bounds(*(*bnd), *(*horz_bound), mapbox::geometry::point<T>(wround<T>((*bnd)->current_x), scanline_y),
                          cliptype, subject_fill_type, clip_fill_type, rings, active_bounds);
-        std::iter_swap(horz_bound, bnd);
+        swap_bounds<T>(horz_bound, bnd, active_bounds);
         horz_bound = bnd;
         ++bnd;
     } // end while (bnd != active_bounds.rend())
@@ -215,15 +215,15 @@ active_bound_list_itr<T> process_horizontal_right_to_left(T scanline_y,
     return next_bnd_itr;
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> process_horizontal(T scanline_y,
                                             active_bound_list_itr<T>& horz_bound,
                                             active_bound_list<T>& active_bounds,
                                             ring_manager<T>& rings,
                                             scanbeam_list<T>& scanbeam,
-                                            clip_type cliptype,
-                                            fill_type subject_fill_type,
-                                            fill_type clip_fill_type) {
+                                            Clip cliptype,
+                                            SubjectFill subject_fill_type,
+                                            ClipFill clip_fill_type) {
     if ((*horz_bound)->current_edge->bot.x < (*horz_bound)->current_edge->top.x) {
         return process_horizontal_left_to_right(scanline_y, horz_bound, active_bounds, rings, scanbeam, cliptype,
                                                 subject_fill_type, clip_fill_type);
@@ -233,14 +233,14 @@ active_bound_list_itr<T> process_horizontal(T scanline_y,
     }
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void process_horizontals(T scanline_y,
                          active_bound_list<T>& active_bounds,
                          ring_manager<T>& rings,
                          scanbeam_list<T>& scanbeam,
-                         clip_type cliptype,
-                         fill_type subject_fill_type,
-                         fill_type clip_fill_type) {
+                         Clip cliptype,
+                         SubjectFill subject_fill_type,
+                         ClipFill clip_fill_type) {
     for (auto bnd_itr = active_bounds.begin(); bnd_itr != active_bounds.end();) {
         if (*bnd_itr != nullptr && current_edge_is_horizontal<T>(bnd_itr)) {
             bnd_itr = process_horizontal(scanline_y, bnd_itr, active_bounds, rings, scanbeam, cliptype,
@@ -249,7 +249,7 @@ void process_horizontals(T scanline_y,
             ++bnd_itr;
         }
     }
-    active_bounds.erase(std::remove(active_bounds.begin(), active_bounds.end(), nullptr), active_bounds.end());
+    remove_null_bounds(active_bounds);
 }
 } // namespace wagyu
 } // namespace geometry
@@ -17,12 +17,12 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
                                    active_bound_list_itr<T>& bndMaxPair,
-                                   clip_type cliptype,
-                                   fill_type subject_fill_type,
-                                   fill_type clip_fill_type,
+                                   Clip cliptype,
+                                   SubjectFill subject_fill_type,
+                                   ClipFill clip_fill_type,
                                    ring_manager<T>& manager,
                                    active_bound_list<T>& active_bounds) {
     auto bnd_next = std::next(bnd);
@@ -36,7 +36,7 @@ active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
         skipped = true;
         intersect_bounds(*(*bnd), *(*bnd_next), (*bnd)->current_edge->top, cliptype, subject_fill_type, clip_fill_type,
                          manager, active_bounds);
-        std::iter_swap(bnd, bnd_next);
+        swap_bounds<T>(bnd, bnd_next, active_bounds);
         bnd = bnd_next;
         ++bnd_next;
     }
@@ -54,16 +54,16 @@ active_bound_list_itr<T> do_maxima(active_bound_list_itr<T>& bnd,
     return return_bnd;
 }
 
-template <typename T>
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
 void process_edges_at_top_of_scanbeam(T top_y,
                                       active_bound_list<T>& active_bounds,
                                       scanbeam_list<T>& scanbeam,
                                       local_minimum_ptr_list<T> const& minima_sorted,
                                       local_minimum_ptr_list_itr<T>& current_lm,
                                       ring_manager<T>& manager,
-                                      clip_type cliptype,
-                                      fill_type subject_fill_type,
-                                      fill_type clip_fill_type) {
+                                      Clip cliptype,
+                                      SubjectFill subject_fill_type,
+                                      ClipFill clip_fill_type) {
 
     for (auto bnd = active_bounds.begin(); bnd != active_bounds.end();) {
         interrupt_check(); // Check for interruptions
@@ -100,7 +100,7 @@ void process_edges_at_top_of_scanbeam(T top_y,
         }
         ++bnd;
     }
-    active_bounds.erase(std::remove(active_bounds.begin(), active_bounds.end(), nullptr), active_bounds.end());
+    remove_null_bounds(active_bounds);
 
     insert_horizontal_local_minima_into_ABL(top_y, minima_sorted, current_lm, active_bounds, manager, scanbeam,
                                             cliptype, subject_fill_type, clip_fill_type);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <mapbox/geometry/wagyu/cluster.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+
+/**
+ * A stable least significant digit radix sort on unsigned keys, used for the large sorts of
+ * points on integer coordinates. Keys are offsets from the smallest (or, for descending keys,
+ * largest) coordinate, computed with unsigned arithmetic so that any range of a signed type fits.
+ * Several keys are packed into one when their bits fit in 64, and sorting on more bits is done by
+ * sorting on the less significant keys first, as each sort keeps the order of equal keys.
+ *
+ * The digits of all passes are counted in one read of the values, and a pass is skipped when
+ * every value has the same digit there. With more than one thread the values are split in blocks
+ * that are counted and scattered on their own, each block writing at the offsets its counts add
+ * up to. Blocks are counted again before each pass after the first, as values move between them.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+// Smaller arrays are sorted with a comparison sort
+constexpr std::size_t radix_sort_min_size = 1024;
+
+// Arrays are split over threads in blocks no smaller than this
+constexpr std::size_t radix_sort_block_min_size = 262144;
+
+constexpr std::size_t radix_digit_bits = 11;
+constexpr std::size_t radix_digit_values = std::size_t(1) << radix_digit_bits;
+
+template <typename T>
+inline std::uint64_t radix_key_ascending(T value, T min) {
+    return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min);
+}
+
+template <typename T>
+inline std::uint64_t radix_key_descending(T value, T max) {
+    return static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(value);
+}
+
+inline std::size_t radix_key_bits(std::uint64_t max_key) {
+    std::size_t bits = 0;
+    while (max_key != 0) {
+        ++bits;
+        max_key >>= 1;
+    }
+    return bits;
+}
+
+// Puts `high` above the `low_bits` bits of `low`
+inline std::uint64_t radix_key_pack(std::uint64_t high, std::uint64_t low, std::size_t low_bits) {
+    if (low_bits >= 64) {
+        return low;
+    }
+    return (high << low_bits) | low;
+}
+
+// Stable sort of `values` on the low `bits` bits of key(value)
+template <typename Value, typename Allocator, typename Key>
+void radix_sort(std::vector<Value, Allocator>& values, Key key, std::size_t bits, std::size_t threads) {
+    using count_vector = std::vector<std::size_t, resource_allocator<std::size_t>>;
+    std::size_t n = values.size();
+    std::size_t digits = (bits + radix_digit_bits - 1) / radix_digit_bits;
+    if (n < 2 || digits == 0) {
+        return;
+    }
+    std::size_t blocks = std::max(std::size_t(1), std::min(threads, n / radix_sort_block_min_size));
+    std::size_t block_size = (n + blocks - 1) / blocks;
+    std::uint64_t const mask = radix_digit_values - 1;
+
+    // counts[(b * digits + d) * radix_digit_values + v] is how many values of block b have v as
+    // their digit d, and later the position the next of them is written at
+    count_vector counts(blocks * digits * radix_digit_values, 0);
+    auto count_block = [&](std::size_t b) {
+        std::size_t* c = &counts[b * digits * radix_digit_values];
+        std::size_t last = std::min(n, (b + 1) * block_size);
+        for (std::size_t i = b * block_size; i < last; ++i) {
+            std::uint64_t k = key(values[i]);
+            for (std::size_t d = 0; d < digits; ++d) {
+                ++c[d * radix_digit_values + ((k >> (d * radix_digit_bits)) & mask)];
+            }
+        }
+    };
+    if (blocks > 1) {
+        run_concurrently(blocks, blocks, current_resource(), count_block);
+    } else {
+        count_block(0);
+    }
+
+    std::vector<Value, Allocator> buffer(n, Value(), values.get_allocator());
+    bool scattered = false;
+    for (std::size_t d = 0; d < digits; ++d) {
+        std::size_t shift = d * radix_digit_bits;
+        if (blocks > 1 && scattered) {
+            // The values have moved between blocks since they were counted
+            run_concurrently(blocks, blocks, current_resource(), [&](std::size_t b) {
+                std::size_t* c = &counts[(b * digits + d) * radix_digit_values];
+                std::fill(c, c + radix_digit_values, 0);
+                std::size_t last = std::min(n, (b + 1) * block_size);
+                for (std::size_t i = b * block_size; i < last; ++i) {
+                    ++c[(key(values[i]) >> shift) & mask];
+                }
+            });
+        }
+        std::size_t offset = 0;
+        bool single_value = false;
+        for (std::size_t v = 0; v < radix_digit_values && !single_value; ++v) {
+            std::size_t total = 0;
+            for (std::size_t b = 0; b < blocks; ++b) {
+                std::size_t& c = counts[(b * digits + d) * radix_digit_values + v];
+                std::size_t count = c;
+                c = offset + total;
+                total += count;
+            }
+            single_value = total == n;
+            offset += total;
+        }
+        if (single_value) {
+            continue;
+        }
+        auto scatter_block = [&](std::size_t b) {
+            std::size_t* c = &counts[(b * digits + d) * radix_digit_values];
+            std::size_t last = std::min(n, (b + 1) * block_size);
+            for (std::size_t i = b * block_size; i < last; ++i) {
+                buffer[c[(key(values[i]) >> shift) & mask]++] = values[i];
+            }
+        };
+        if (blocks > 1) {
+            run_concurrently(blocks, blocks, current_resource(), scatter_block);
+        } else {
+            scatter_block(0);
+        }
+        values.swap(buffer);
+        scattered = true;
+    }
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <assert.h>
 #include <cmath>
+#include <cstdint>
 #include <deque>
+#include <limits>
 #include <list>
 #include <map>
 #include <mapbox/geometry/box.hpp>
+#include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/point.hpp>
+#include <mapbox/geometry/wagyu/ring_edge_index.hpp>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #ifdef DEBUG
@@ -61,10 +67,20 @@ double area_from_point(point_ptr<T> op, std::size_t& size, mapbox::geometry::box
     return a * 0.5;
 }
 
+// Twice the signed area between the edge from op1 to op2 and the y axis, as area_from_point
+// adds it up
+template <typename T>
+inline double area_term(point_ptr<T> op1, point_ptr<T> op2) {
+    return static_cast<double>(op1->x + op2->x) * static_cast<double>(op1->y - op2->y);
+}
+
+// Area terms are whole numbers, so adding them up is exact below this
+constexpr double exact_area_terms_max = 9007199254740992.0; // 2^53
+
 // NOTE: ring and ring_ptr are forward declared in wagyu/point.hpp
 
 template <typename T>
-using ring_vector = std::vector<ring_ptr<T>>;
+using ring_vector = std::vector<ring_ptr<T>, resource_allocator<ring_ptr<T>>>;
 
 template <typename T>
 struct ring {
@@ -72,6 +88,7 @@ struct ring {
 
     std::size_t size_;             // number of points in the ring
     double area_;                  // area of the ring
+    double area_terms_;            // magnitudes of the terms area_ was kept up to date with
     mapbox::geometry::box<T> bbox; // bounding box of the ring
 
     ring_ptr<T> parent;
@@ -79,27 +96,33 @@ struct ring {
 
     point_ptr<T> points;
     point_ptr<T> bottom_point;
+    ring_edge_index<T> edge_index; // built on demand for point in polygon tests
     bool is_hole_;
     bool corrected;
 
     ring(ring const&) = delete;
     ring& operator=(ring const&) = delete;
+    ring(ring&&) = default;
 
     ring()
         : ring_index(0),
           size_(0),
           area_(std::numeric_limits<double>::quiet_NaN()),
+          area_terms_(0.0),
           bbox({ 0, 0 }, { 0, 0 }),
           parent(nullptr),
           children(),
           points(nullptr),
           bottom_point(nullptr),
+          edge_index(),
           is_hole_(false),
           corrected(false) {
     }
 
     void reset_stats() {
+        edge_index.clear();
         area_ = std::numeric_limits<double>::quiet_NaN();
+        area_terms_ = 0.0;
         is_hole_ = false;
         bbox.min.x = 0;
         bbox.min.y = 0;
@@ -109,6 +132,7 @@ struct ring {
     }
 
     void recalculate_stats() {
+        edge_index.clear();
         if (points != nullptr) {
             area_ = area_from_point(points, size_, bbox);
             is_hole_ = !(area_ > 0.0);
@@ -116,12 +140,79 @@ struct ring {
     }
 
     void set_stats(double a, std::size_t s, mapbox::geometry::box<T> const& b) {
+        edge_index.clear();
         bbox = b;
         area_ = a;
         size_ = s;
         is_hole_ = !(area_ > 0.0);
     }
 
+    // While the sweep builds a ring its stats are kept up to date as points are linked in, so
+    // that they do not have to be worked out from all the points afterwards. This gives exactly
+    // what area_from_point would for as long as the terms added up fit in a double, after that
+    // the stats are left unknown.
+    void start_stats(point_ptr<T> op) {
+        edge_index.clear();
+        area_ = 0.0;
+        area_terms_ = 0.0;
+        size_ = 1;
+        bbox.min.x = op->x;
+        bbox.min.y = op->y;
+        bbox.max.x = op->x;
+        bbox.max.y = op->y;
+        is_hole_ = true;
+    }
+
+    // Adds `sum` to twice the area, `magnitude` being the sum of the magnitudes of its terms
+    void add_area_terms(double sum, double magnitude) {
+        if (std::isnan(area_)) {
+            return;
+        }
+        area_terms_ += magnitude;
+        if (!(area_terms_ < exact_area_terms_max)) {
+            reset_stats();
+            return;
+        }
+        area_ += sum * 0.5;
+        is_hole_ = !(area_ > 0.0);
+    }
+
+    // For a point just linked in between its prev and next
+    void add_point_to_stats(point_ptr<T> op) {
+        if (std::isnan(area_)) {
+            return;
+        }
+        ++size_;
+        bbox.min.x = std::min(bbox.min.x, op->x);
+        bbox.min.y = std::min(bbox.min.y, op->y);
+        bbox.max.x = std::max(bbox.max.x, op->x);
+        bbox.max.y = std::max(bbox.max.y, op->y);
+        double removed = area_term(op->prev, op->next);
+        double added_1 = area_term(op->prev, op);
+        double added_2 = area_term(op, op->next);
+        add_area_terms(added_1 + added_2 - removed, std::fabs(added_1) + std::fabs(added_2) + std::fabs(removed));
+    }
+
+    // For the points of another ring, reversed or not, about to be spliced in. The edges that
+    // are replaced and added by the splice still have to be added with add_area_terms.
+    void add_ring_to_stats(ring<T> const& other, bool reversed) {
+        if (std::isnan(area_) || std::isnan(other.area_)) {
+            reset_stats();
+            return;
+        }
+        size_ += other.size_;
+        bbox.min.x = std::min(bbox.min.x, other.bbox.min.x);
+        bbox.min.y = std::min(bbox.min.y, other.bbox.min.y);
+        bbox.max.x = std::max(bbox.max.x, other.bbox.max.x);
+        bbox.max.y = std::max(bbox.max.y, other.bbox.max.y);
+        area_terms_ += other.area_terms_;
+        area_ += reversed ? -other.area_ : other.area_;
+    }
+
+    bool stats_known() const {
+        return !std::isnan(area_);
+    }
+
     double area() {
         if (std::isnan(area_)) {
             recalculate_stats();
@@ -145,7 +236,7 @@ struct ring {
 };
 
 template <typename T>
-using hot_pixel_vector = std::vector<mapbox::geometry::point<T>>;
+using hot_pixel_vector = std::vector<mapbox::geometry::point<T>, resource_allocator<mapbox::geometry::point<T>>>;
 
 template <typename T>
 using hot_pixel_itr = typename hot_pixel_vector<T>::iterator;
@@ -153,6 +244,15 @@ using hot_pixel_itr = typename hot_pixel_vector<T>::iterator;
 template <typename T>
 using hot_pixel_rev_itr = typename hot_pixel_vector<T>::reverse_iterator;
 
+#ifdef USE_WAGYU_COMPACT_LINKS
+// Rings are addressed by index so they can live in a vector
+template <typename T>
+using ring_pool = std::vector<ring<T>, resource_allocator<ring<T>>>;
+#else
+template <typename T>
+using ring_pool = std::deque<ring<T>, resource_allocator<ring<T>>>;
+#endif
+
 template <typename T>
 struct ring_manager {
 
@@ -160,23 +260,62 @@ struct ring_manager {
     point_vector<T> all_points;
     hot_pixel_vector<T> hot_pixels;
     hot_pixel_itr<T> current_hp_itr;
-    std::deque<point<T>> points;
-    std::deque<ring<T>> rings;
-    std::vector<point<T>> storage;
+    std::deque<point<T>, resource_allocator<point<T>>> points;
+    ring_pool<T> rings;
+    std::vector<point<T>, resource_allocator<point<T>>> storage;
     std::size_t index;
+    crossing_sort_type crossing_method;
 
     ring_manager(ring_manager const&) = delete;
     ring_manager& operator=(ring_manager const&) = delete;
 
-    ring_manager()
-        : children(),
-          all_points(),
-          hot_pixels(),
+    ring_manager() : ring_manager(get_default_resource()) {
+    }
+
+    explicit ring_manager(memory_resource* resource)
+        : children(resource),
+          all_points(resource),
+          hot_pixels(resource),
           current_hp_itr(hot_pixels.end()),
-          points(),
-          rings(),
-          storage(),
-          index(0) {
+          points(resource),
+          rings(resource),
+          storage(resource),
+          index(0),
+          crossing_method(crossing_sort_adaptive) {
+    }
+
+    // Rewinds the manager so it can be used for another execution
+    // without giving any of its memory back. Rings are recycled in
+    // place by create_new_ring and any points that overflowed into
+    // the point deque are folded into the contiguous storage.
+    void reset() {
+        hot_pixels.clear();
+        reset_rings();
+    }
+
+    // Like reset, but keeps the hot pixels so that another operation
+    // can be run on the same input without snap rounding it again.
+    void reset_rings() {
+        children.clear();
+        all_points.clear();
+        current_hp_itr = hot_pixels.end();
+        std::size_t used = storage.size() + points.size();
+        storage.clear();
+        if (used > storage.capacity()) {
+            storage.reserve(used);
+        }
+        points.clear();
+        index = 0;
+        bind_pools();
+    }
+
+    // Makes the storage of this manager the pools that compact links
+    // resolve against on the calling thread.
+    void bind_pools() {
+#ifdef USE_WAGYU_COMPACT_LINKS
+        pool_ptr<point<T>>::base() = storage.data();
+        pool_ptr<ring<T>>::base() = rings.data();
+#endif
     }
 };
 
@@ -184,16 +323,69 @@ template <typename T>
 void preallocate_point_memory(ring_manager<T>& rings, std::size_t size) {
     rings.storage.reserve(size);
     rings.all_points.reserve(size);
+    rings.bind_pools();
 }
 
 template <typename T>
 ring_ptr<T> create_new_ring(ring_manager<T>& manager) {
-    manager.rings.emplace_back();
-    ring_ptr<T> result = &manager.rings.back();
+    ring_ptr<T> result;
+    if (manager.index < manager.rings.size()) {
+        // Recycle a ring left over from a previous execution
+        result = &manager.rings[manager.index];
+        result->reset_stats();
+        result->parent = nullptr;
+        result->children.clear();
+        result->points = nullptr;
+        result->bottom_point = nullptr;
+        result->corrected = false;
+    } else {
+        manager.rings.emplace_back();
+        manager.bind_pools();
+        result = &manager.rings.back();
+    }
     result->ring_index = manager.index++;
     return result;
 }
 
+#ifdef USE_WAGYU_COMPACT_LINKS
+
+template <typename T>
+void reserve_point_storage(ring_manager<T>& rings) {
+    // All points must live in storage, it is grown here rather than by
+    // emplace_back so the pool is rebound before a point links itself in.
+    if (rings.storage.size() < rings.storage.capacity()) {
+        return;
+    }
+    if (rings.storage.size() >= std::numeric_limits<std::uint32_t>::max() - 1) {
+        throw std::runtime_error("Too many points for compact links");
+    }
+    rings.storage.reserve(std::max(static_cast<std::size_t>(64), rings.storage.capacity() * 2));
+    rings.bind_pools();
+}
+
+template <typename T>
+point_ptr<T> create_new_point(ring_ptr<T> r, mapbox::geometry::point<T> const& pt, ring_manager<T>& rings) {
+    reserve_point_storage(rings);
+    rings.storage.emplace_back(r, pt);
+    point_ptr<T> point = &rings.storage.back();
+    rings.all_points.push_back(point);
+    return point;
+}
+
+template <typename T>
+point_ptr<T> create_new_point(ring_ptr<T> r,
+                              mapbox::geometry::point<T> const& pt,
+                              point_ptr<T> before_this_point,
+                              ring_manager<T>& rings) {
+    reserve_point_storage(rings);
+    rings.storage.emplace_back(r, pt, before_this_point);
+    point_ptr<T> point = &rings.storage.back();
+    rings.all_points.push_back(point);
+    return point;
+}
+
+#else
+
 template <typename T>
 point_ptr<T> create_new_point(ring_ptr<T> r, mapbox::geometry::point<T> const& pt, ring_manager<T>& rings) {
     point_ptr<T> point;
@@ -225,6 +417,8 @@ point_ptr<T> create_new_point(ring_ptr<T> r,
     return point;
 }
 
+#endif
+
 template <typename T>
 void set_to_children(ring_ptr<T> r, ring_vector<T>& children) {
     for (auto& c : children) {
@@ -512,7 +706,7 @@ inline std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, t
         // out << "  parent_ring ptr: " << r.parent << std::endl;
         out << "  parent_ring idx: " << r.parent->ring_index << std::endl;
     }
-    ring_ptr<T> n = const_cast<ring_ptr<T>>(&r);
+    ring_ptr<T> n = &r;
     if (ring_is_hole(n)) {
         out << "  is_hole: true " << std::endl;
     } else {
@@ -605,7 +799,7 @@ inline std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, t
 
 template <class charT, class traits, typename T>
 inline std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& out,
-                                                     std::deque<ring<T>>& rings) {
+                                                     ring_pool<T>& rings) {
     out << "START RING VECTOR" << std::endl;
     for (auto& r : rings) {
         if (!r.points) {
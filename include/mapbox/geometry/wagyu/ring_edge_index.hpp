@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <mapbox/geometry/point.hpp>
+
+#include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+#include <mapbox/geometry/wagyu/point.hpp>
+
+/**
+ * Only the edges of a ring whose y range takes in the y of a point can change whether that point
+ * is inside the ring. For large rings that are tested against many points the edges are kept in
+ * an interval tree over their y ranges, so that a test only looks at those edges instead of
+ * walking the whole ring.
+ *
+ * Each node of the tree has a center y and holds the edges whose range takes in that y, once
+ * sorted by the bottom of their range and once by the top. Edges entirely below or above the
+ * center go to the child on that side. The edges are copied, so that a stale index never points
+ * at points that have been removed from the ring, but it must be cleared whenever the points of
+ * the ring change. The ring does this wherever its stats are set or reset.
+ */
+
+namespace mapbox {
+namespace geometry {
+namespace wagyu {
+
+// Rings with fewer points are always walked
+constexpr std::size_t ring_edge_index_min_points = 64;
+
+template <typename T>
+struct ring_edge {
+    mapbox::geometry::point<T> pt1;
+    mapbox::geometry::point<T> pt2;
+    T min_y;
+    T max_y;
+};
+
+template <typename T>
+struct ring_edge_index_node {
+    T center;
+    std::size_t first;
+    std::size_t last;
+    std::size_t below;
+    std::size_t above;
+};
+
+template <typename T>
+struct ring_edge_index {
+    using index_vector = std::vector<std::size_t, resource_allocator<std::size_t>>;
+
+    static constexpr std::size_t no_node = std::numeric_limits<std::size_t>::max();
+
+    std::vector<ring_edge<T>, resource_allocator<ring_edge<T>>> edges;
+    std::vector<ring_edge_index_node<T>, resource_allocator<ring_edge_index_node<T>>> nodes;
+    index_vector by_min_y;
+    index_vector by_max_y;
+    std::size_t queries; // queries since the ring last changed
+
+    ring_edge_index() : edges(), nodes(), by_min_y(), by_max_y(), queries(0) {
+    }
+
+    void clear() {
+        edges.clear();
+        nodes.clear();
+        by_min_y.clear();
+        by_max_y.clear();
+        queries = 0;
+    }
+
+    bool built() const {
+        return !nodes.empty();
+    }
+};
+
+template <typename T>
+constexpr std::size_t ring_edge_index<T>::no_node;
+
+template <typename T>
+std::size_t build_ring_edge_index_node(ring_edge_index<T>& index, typename ring_edge_index<T>::index_vector& items) {
+    using index_vector = typename ring_edge_index<T>::index_vector;
+    std::vector<T, resource_allocator<T>> ys;
+    ys.reserve(items.size() * 2);
+    for (auto i : items) {
+        ys.push_back(index.edges[i].min_y);
+        ys.push_back(index.edges[i].max_y);
+    }
+    auto mid = ys.begin() + static_cast<std::ptrdiff_t>(ys.size() / 2);
+    std::nth_element(ys.begin(), mid, ys.end());
+    T center = *mid;
+
+    index_vector below;
+    index_vector above;
+    std::size_t first = index.by_min_y.size();
+    for (auto i : items) {
+        auto const& e = index.edges[i];
+        if (e.max_y < center) {
+            below.push_back(i);
+        } else if (e.min_y > center) {
+            above.push_back(i);
+        } else {
+            index.by_min_y.push_back(i);
+            index.by_max_y.push_back(i);
+        }
+    }
+    std::size_t last = index.by_min_y.size();
+    auto const& edges = index.edges;
+    std::sort(index.by_min_y.begin() + static_cast<std::ptrdiff_t>(first), index.by_min_y.end(),
+              [&edges](std::size_t i1, std::size_t i2) { return edges[i1].min_y < edges[i2].min_y; });
+    std::sort(index.by_max_y.begin() + static_cast<std::ptrdiff_t>(first), index.by_max_y.end(),
+              [&edges](std::size_t i1, std::size_t i2) { return edges[i1].max_y > edges[i2].max_y; });
+
+    std::size_t node = index.nodes.size();
+    index.nodes.push_back({ center, first, last, ring_edge_index<T>::no_node, ring_edge_index<T>::no_node });
+    if (!below.empty()) {
+        std::size_t child = build_ring_edge_index_node(index, below);
+        index.nodes[node].below = child;
+    }
+    if (!above.empty()) {
+        std::size_t child = build_ring_edge_index_node(index, above);
+        index.nodes[node].above = child;
+    }
+    return node;
+}
+
+template <typename T>
+void build_ring_edge_index(ring_edge_index<T>& index, point_ptr<T> first_pt) {
+    index.edges.clear();
+    index.nodes.clear();
+    index.by_min_y.clear();
+    index.by_max_y.clear();
+    point_ptr<T> op = first_pt;
+    do {
+        point_ptr<T> next = op->next;
+        index.edges.push_back({ mapbox::geometry::point<T>(op->x, op->y), mapbox::geometry::point<T>(next->x, next->y),
+                                std::min(op->y, next->y), std::max(op->y, next->y) });
+        op = next;
+    } while (op != first_pt);
+    typename ring_edge_index<T>::index_vector items(index.edges.size());
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        items[i] = i;
+    }
+    index.by_min_y.reserve(items.size());
+    index.by_max_y.reserve(items.size());
+    build_ring_edge_index_node(index, items);
+}
+
+// Calls fn(edge) for every edge whose y range meets [lo, hi] until it returns true
+template <typename T, typename Y, typename Fn>
+bool find_ring_edges(ring_edge_index<T> const& index, Y lo, Y hi, Fn fn) {
+    std::size_t stack[std::numeric_limits<std::size_t>::digits * 2];
+    std::size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0) {
+        auto const& node = index.nodes[stack[--size]];
+        auto center = static_cast<Y>(node.center);
+        if (hi < center) {
+            for (std::size_t k = node.first; k < node.last; ++k) {
+                auto const& e = index.edges[index.by_min_y[k]];
+                if (static_cast<Y>(e.min_y) > hi) {
+                    break;
+                }
+                if (fn(e)) {
+                    return true;
+                }
+            }
+        } else if (lo > center) {
+            for (std::size_t k = node.first; k < node.last; ++k) {
+                auto const& e = index.edges[index.by_max_y[k]];
+                if (static_cast<Y>(e.max_y) < lo) {
+                    break;
+                }
+                if (fn(e)) {
+                    return true;
+                }
+            }
+        } else {
+            for (std::size_t k = node.first; k < node.last; ++k) {
+                if (fn(index.edges[index.by_min_y[k]])) {
+                    return true;
+                }
+            }
+        }
+        if (lo < center && node.below != ring_edge_index<T>::no_node) {
+            stack[size++] = node.below;
+        }
+        if (hi > center && node.above != ring_edge_index<T>::no_node) {
+            stack[size++] = node.above;
+        }
+    }
+    return false;
+}
+} // namespace wagyu
+} // namespace geometry
+} // namespace mapbox
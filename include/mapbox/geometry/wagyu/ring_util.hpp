@@ -16,10 +16,14 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
 
 #include <mapbox/geometry/wagyu/active_bound_list.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
 #include <mapbox/geometry/wagyu/edge.hpp>
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
@@ -29,8 +33,7 @@ namespace wagyu {
 
 template <typename T>
 void set_hole_state(bound<T>& bnd, active_bound_list<T> const& active_bounds, ring_manager<T>& rings) {
-    auto bnd_itr = std::find(active_bounds.rbegin(), active_bounds.rend(), &bnd);
-    ++bnd_itr;
+    auto bnd_itr = typename active_bound_list<T>::const_reverse_iterator(find_bound(&bnd, active_bounds));
     bound_ptr<T> bndTmp = nullptr;
     // Find first non line ring to the left of current bound.
     while (bnd_itr != active_bounds.rend()) {
@@ -189,6 +192,7 @@ void hot_pixel_set_left_to_right(T y,
             continue;
         }
         point_ptr<T> new_point = create_new_point(bnd.ring, *itr, op, rings);
+        bnd.ring->add_point_to_stats(new_point);
         if (to_front) {
             bnd.ring->points = new_point;
         }
@@ -226,6 +230,7 @@ void hot_pixel_set_right_to_left(T y,
             continue;
         }
         point_ptr<T> new_point = create_new_point(bnd.ring, *itr, op, rings);
+        bnd.ring->add_point_to_stats(new_point);
         if (to_front) {
             bnd.ring->points = new_point;
         }
@@ -233,12 +238,56 @@ void hot_pixel_set_right_to_left(T y,
 }
 
 template <typename T>
-void sort_hot_pixels(ring_manager<T>& rings) {
+void sort_hot_pixels(ring_manager<T>& rings, std::size_t, std::false_type) {
     std::sort(rings.hot_pixels.begin(), rings.hot_pixels.end(), hot_pixel_sorter<T>());
+}
+
+template <typename T>
+void sort_hot_pixels(ring_manager<T>& rings, std::size_t threads, std::true_type) {
+    auto& hot_pixels = rings.hot_pixels;
+    if (hot_pixels.size() < radix_sort_min_size) {
+        sort_hot_pixels(rings, threads, std::false_type());
+        return;
+    }
+    T min_y = hot_pixels.front().y;
+    T max_y = min_y;
+    T min_x = hot_pixels.front().x;
+    T max_x = min_x;
+    for (auto const& hp : hot_pixels) {
+        min_y = std::min(min_y, hp.y);
+        max_y = std::max(max_y, hp.y);
+        min_x = std::min(min_x, hp.x);
+        max_x = std::max(max_x, hp.x);
+    }
+    std::size_t y_bits = radix_key_bits(radix_key_descending(min_y, max_y));
+    std::size_t x_bits = radix_key_bits(radix_key_ascending(max_x, min_x));
+    if (y_bits + x_bits <= 64) {
+        radix_sort(hot_pixels,
+                   [max_y, min_x, x_bits](mapbox::geometry::point<T> const& hp) {
+                       return radix_key_pack(radix_key_descending(hp.y, max_y), radix_key_ascending(hp.x, min_x),
+                                             x_bits);
+                   },
+                   y_bits + x_bits, threads);
+        return;
+    }
+    radix_sort(hot_pixels, [min_x](mapbox::geometry::point<T> const& hp) { return radix_key_ascending(hp.x, min_x); },
+               x_bits, threads);
+    radix_sort(hot_pixels, [max_y](mapbox::geometry::point<T> const& hp) { return radix_key_descending(hp.y, max_y); },
+               y_bits, threads);
+}
+
+template <typename T>
+void sort_hot_pixels(ring_manager<T>& rings, std::size_t threads) {
+    sort_hot_pixels(rings, threads, std::is_integral<T>());
     auto last = std::unique(rings.hot_pixels.begin(), rings.hot_pixels.end());
     rings.hot_pixels.erase(last, rings.hot_pixels.end());
 }
 
+template <typename T>
+void sort_hot_pixels(ring_manager<T>& rings) {
+    sort_hot_pixels(rings, 1);
+}
+
 template <typename T>
 void insert_hot_pixels_in_path(bound<T>& bnd,
                                mapbox::geometry::point<T> const& end_pt,
@@ -311,6 +360,7 @@ void add_first_point(bound<T>& bnd,
     ring_ptr<T> r = create_new_ring(rings);
     bnd.ring = r;
     r->points = create_new_point(r, pt, rings);
+    r->start_stats(r->points);
     set_hole_state(bnd, active_bounds, rings);
     bnd.last_point = pt;
 }
@@ -331,6 +381,7 @@ void add_point_to_ring(bound<T>& bnd, mapbox::geometry::point<T> const& pt, ring
         return;
     }
     point_ptr<T> new_point = create_new_point(bnd.ring, pt, bnd.ring->points, rings);
+    bnd.ring->add_point_to_stats(new_point);
     if (to_front) {
         bnd.ring->points = new_point;
     }
@@ -540,6 +591,12 @@ void append_ring(bound<T>& b1, bound<T>& b2, active_bound_list<T>& active_bounds
     point_ptr<T> p2_lft = remove_ring->points;
     point_ptr<T> p2_rt = p2_lft->prev;
 
+    // The edges closing both rings are replaced by two edges joining them
+    bool reversed = keep_bound->side == remove_bound->side;
+    double removed_1 = area_term(p1_rt, p1_lft);
+    double removed_2 = reversed ? -area_term(p2_rt, p2_lft) : area_term(p2_rt, p2_lft);
+    keep_ring->add_ring_to_stats(*remove_ring, reversed);
+
     // join b2 poly onto b1 poly and delete pointers to b2 ...
     if (keep_bound->side == edge_left) {
         if (remove_bound->side == edge_left) {
@@ -575,12 +632,18 @@ void append_ring(bound<T>& b1, bound<T>& b2, active_bound_list<T>& active_bounds
         }
     }
 
+    double added_1 = area_term(p1_lft->prev, p1_lft);
+    double added_2 = area_term(p1_rt, p1_rt->next);
+    keep_ring->add_area_terms(added_1 + added_2 - removed_1 - removed_2,
+                              std::fabs(added_1) + std::fabs(added_2) + std::fabs(removed_1) + std::fabs(removed_2));
+
     keep_ring->bottom_point = nullptr;
     bool keep_is_hole = ring_is_hole(keep_ring);
     bool remove_is_hole = ring_is_hole(remove_ring);
 
     remove_ring->points = nullptr;
     remove_ring->bottom_point = nullptr;
+    remove_ring->reset_stats();
     if (keep_is_hole != remove_is_hole) {
         ring1_replaces_ring2(keep_ring->parent, remove_ring, manager);
     } else {
@@ -630,20 +693,35 @@ enum point_in_polygon_result : std::int8_t {
     point_outside_polygon = 1
 };
 
-template <typename T>
-point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
-    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
-    point_in_polygon_result result = point_outside_polygon;
-    point_ptr<T> startOp = op;
-    do {
-        if (op->next->y == pt.y) {
-            if ((op->next->x == pt.x) || (op->y == pt.y && ((op->next->x > pt.x) == (op->x < pt.x)))) {
-                return point_on_polygon;
-            }
+// Flips `result` if the ray from pt to the right crosses the edge from `a` to `b`.
+// Returns true if pt is on the edge.
+template <typename T, typename Point>
+inline bool point_in_polygon_edge(point<T> const& pt,
+                                  Point const& a,
+                                  Point const& b,
+                                  point_in_polygon_result& result) {
+    if (b.y == pt.y) {
+        if ((b.x == pt.x) || (a.y == pt.y && ((b.x > pt.x) == (a.x < pt.x)))) {
+            return true;
         }
-        if ((op->y < pt.y) != (op->next->y < pt.y)) {
-            if (op->x >= pt.x) {
-                if (op->next->x > pt.x) {
+    }
+    if ((a.y < pt.y) != (b.y < pt.y)) {
+        if (a.x >= pt.x) {
+            if (b.x > pt.x) {
+                // Switch between point outside polygon and point inside
+                // polygon
+                if (result == point_outside_polygon) {
+                    result = point_inside_polygon;
+                } else {
+                    result = point_outside_polygon;
+                }
+            } else {
+                double d = static_cast<double>(a.x - pt.x) * static_cast<double>(b.y - pt.y) -
+                           static_cast<double>(b.x - pt.x) * static_cast<double>(a.y - pt.y);
+                if (value_is_zero(d)) {
+                    return true;
+                }
+                if ((d > 0) == (b.y > a.y)) {
                     // Switch between point outside polygon and point inside
                     // polygon
                     if (result == point_outside_polygon) {
@@ -651,65 +729,61 @@ point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
                     } else {
                         result = point_outside_polygon;
                     }
-                } else {
-                    double d = static_cast<double>(op->x - pt.x) * static_cast<double>(op->next->y - pt.y) -
-                               static_cast<double>(op->next->x - pt.x) * static_cast<double>(op->y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0) == (op->next->y > op->y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
-                    }
                 }
-            } else {
-                if (op->next->x > pt.x) {
-                    double d = static_cast<double>(op->x - pt.x) * static_cast<double>(op->next->y - pt.y) -
-                               static_cast<double>(op->next->x - pt.x) * static_cast<double>(op->y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0) == (op->next->y > op->y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
+            }
+        } else {
+            if (b.x > pt.x) {
+                double d = static_cast<double>(a.x - pt.x) * static_cast<double>(b.y - pt.y) -
+                           static_cast<double>(b.x - pt.x) * static_cast<double>(a.y - pt.y);
+                if (value_is_zero(d)) {
+                    return true;
+                }
+                if ((d > 0) == (b.y > a.y)) {
+                    // Switch between point outside polygon and point inside
+                    // polygon
+                    if (result == point_outside_polygon) {
+                        result = point_inside_polygon;
+                    } else {
+                        result = point_outside_polygon;
                     }
                 }
             }
         }
-        op = op->next;
-    } while (startOp != op);
-    return result;
+    }
+    return false;
 }
 
-template <typename T>
-point_in_polygon_result point_in_polygon(mapbox::geometry::point<double> const& pt, point_ptr<T> op) {
-    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
-    point_in_polygon_result result = point_outside_polygon;
-    point_ptr<T> startOp = op;
-    do {
-        double op_x = static_cast<double>(op->x);
-        double op_y = static_cast<double>(op->y);
-        double op_next_x = static_cast<double>(op->next->x);
-        double op_next_y = static_cast<double>(op->next->y);
-        if (values_are_equal(op_next_y, pt.y)) {
-            if (values_are_equal(op_next_x, pt.x) ||
-                (values_are_equal(op_y, pt.y) && ((op_next_x > pt.x) == (op_x < pt.x)))) {
-                return point_on_polygon;
-            }
+template <typename Point>
+inline bool point_in_polygon_edge(mapbox::geometry::point<double> const& pt,
+                                  Point const& a,
+                                  Point const& b,
+                                  point_in_polygon_result& result) {
+    double op_x = static_cast<double>(a.x);
+    double op_y = static_cast<double>(a.y);
+    double op_next_x = static_cast<double>(b.x);
+    double op_next_y = static_cast<double>(b.y);
+    if (values_are_equal(op_next_y, pt.y)) {
+        if (values_are_equal(op_next_x, pt.x) ||
+            (values_are_equal(op_y, pt.y) && ((op_next_x > pt.x) == (op_x < pt.x)))) {
+            return true;
         }
-        if ((op_y < pt.y) != (op_next_y < pt.y)) {
-            if (greater_than_or_equal(op_x, pt.x)) {
-                if (op_next_x > pt.x) {
+    }
+    if ((op_y < pt.y) != (op_next_y < pt.y)) {
+        if (greater_than_or_equal(op_x, pt.x)) {
+            if (op_next_x > pt.x) {
+                // Switch between point outside polygon and point inside
+                // polygon
+                if (result == point_outside_polygon) {
+                    result = point_inside_polygon;
+                } else {
+                    result = point_outside_polygon;
+                }
+            } else {
+                double d = (op_x - pt.x) * (op_next_y - pt.y) - (op_next_x - pt.x) * (op_y - pt.y);
+                if (value_is_zero(d)) {
+                    return true;
+                }
+                if ((d > 0.0) == (op_next_y > op_y)) {
                     // Switch between point outside polygon and point inside
                     // polygon
                     if (result == point_outside_polygon) {
@@ -717,44 +791,100 @@ point_in_polygon_result point_in_polygon(mapbox::geometry::point<double> const&
                     } else {
                         result = point_outside_polygon;
                     }
-                } else {
-                    double d = (op_x - pt.x) * (op_next_y - pt.y) - (op_next_x - pt.x) * (op_y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0.0) == (op_next_y > op_y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
-                    }
                 }
-            } else {
-                if (op_next_x > pt.x) {
-                    double d = (op_x - pt.x) * (op_next_y - pt.y) - (op_next_x - pt.x) * (op_y - pt.y);
-                    if (value_is_zero(d)) {
-                        return point_on_polygon;
-                    }
-                    if ((d > 0.0) == (op_next_y > op_y)) {
-                        // Switch between point outside polygon and point inside
-                        // polygon
-                        if (result == point_outside_polygon) {
-                            result = point_inside_polygon;
-                        } else {
-                            result = point_outside_polygon;
-                        }
+            }
+        } else {
+            if (op_next_x > pt.x) {
+                double d = (op_x - pt.x) * (op_next_y - pt.y) - (op_next_x - pt.x) * (op_y - pt.y);
+                if (value_is_zero(d)) {
+                    return true;
+                }
+                if ((d > 0.0) == (op_next_y > op_y)) {
+                    // Switch between point outside polygon and point inside
+                    // polygon
+                    if (result == point_outside_polygon) {
+                        result = point_inside_polygon;
+                    } else {
+                        result = point_outside_polygon;
                     }
                 }
             }
         }
+    }
+    return false;
+}
+
+template <typename T>
+point_in_polygon_result point_in_polygon(point<T> const& pt, point_ptr<T> op) {
+    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
+    point_in_polygon_result result = point_outside_polygon;
+    point_ptr<T> startOp = op;
+    do {
+        if (point_in_polygon_edge(pt, *op, *(op->next), result)) {
+            return point_on_polygon;
+        }
+        op = op->next;
+    } while (startOp != op);
+    return result;
+}
+
+template <typename T>
+point_in_polygon_result point_in_polygon(mapbox::geometry::point<double> const& pt, point_ptr<T> op) {
+    // returns 0 if false, +1 if true, -1 if pt ON polygon boundary
+    point_in_polygon_result result = point_outside_polygon;
+    point_ptr<T> startOp = op;
+    do {
+        if (point_in_polygon_edge(pt, *op, *(op->next), result)) {
+            return point_on_polygon;
+        }
         op = op->next;
     } while (startOp != op);
     return result;
 }
 
+// Whether the ring is worth indexing for the point in polygon tests against it.
+// The index is built on the second test since the ring changed, so that a ring
+// that is only tested once is just walked.
+template <typename T>
+bool use_ring_edge_index(ring_ptr<T> r) {
+    if (r->edge_index.built()) {
+        return true;
+    }
+    if (r->size() < ring_edge_index_min_points || r->edge_index.queries++ == 0) {
+        return false;
+    }
+    build_ring_edge_index(r->edge_index, r->points);
+    return true;
+}
+
+// Same as walking the points of the ring, every edge that can change the result
+// is looked at and the result does not depend on their order.
+template <typename T>
+point_in_polygon_result point_in_polygon(point<T> const& pt, ring_ptr<T> r) {
+    if (!use_ring_edge_index(r)) {
+        return point_in_polygon(pt, r->points);
+    }
+    point_in_polygon_result result = point_outside_polygon;
+    bool on = find_ring_edges(r->edge_index, pt.y, pt.y, [&pt, &result](ring_edge<T> const& e) {
+        return point_in_polygon_edge(pt, e.pt1, e.pt2, result);
+    });
+    return on ? point_on_polygon : result;
+}
+
+template <typename T>
+point_in_polygon_result point_in_polygon(mapbox::geometry::point<double> const& pt, ring_ptr<T> r) {
+    if (!use_ring_edge_index(r)) {
+        return point_in_polygon(pt, r->points);
+    }
+    // Edges whose ends are only almost at the y of the point count as well
+    double margin = (std::fabs(pt.y) + 1.0) * 1e-12;
+    point_in_polygon_result result = point_outside_polygon;
+    bool on = find_ring_edges(r->edge_index, pt.y - margin, pt.y + margin, [&pt, &result](ring_edge<T> const& e) {
+        return point_in_polygon_edge(pt, e.pt1, e.pt2, result);
+    });
+    return on ? point_on_polygon : result;
+}
+
 template <typename T>
 bool is_convex(point_ptr<T> edge) {
     point_ptr<T> prev = edge->prev;
@@ -803,6 +933,23 @@ point_in_polygon_result inside_or_outside_special(point_ptr<T> first_pt, point_p
     throw std::runtime_error("Could not find a point within the polygon to test");
 }
 
+template <typename T>
+point_in_polygon_result inside_or_outside_special(ring_ptr<T> r1, ring_ptr<T> r2) {
+    point_ptr<T> first_pt = r1->points->next;
+    point_ptr<T> itr = first_pt;
+    do {
+        if (is_convex(itr)) {
+            auto pt = centroid_of_points(itr);
+            if (point_inside_polygon == point_in_polygon(pt, r1)) {
+                return point_in_polygon(pt, r2);
+            }
+        }
+        itr = itr->next;
+    } while (itr != first_pt);
+
+    throw std::runtime_error("Could not find a point within the polygon to test");
+}
+
 template <typename T>
 bool box2_contains_box1(mapbox::geometry::box<T> const& box1, mapbox::geometry::box<T> const& box2) {
     return (box2.max.x >= box1.max.x && box2.max.y >= box1.max.y && box2.min.x <= box1.min.x &&
@@ -818,17 +965,16 @@ bool poly2_contains_poly1(ring_ptr<T> ring1, ring_ptr<T> ring2) {
         return false;
     }
     point_ptr<T> outpt1 = ring1->points->next;
-    point_ptr<T> outpt2 = ring2->points->next;
     point_ptr<T> op = outpt1;
     do {
         // nb: PointInPolygon returns 0 if false, +1 if true, -1 if pt on polygon
-        point_in_polygon_result res = point_in_polygon(*op, outpt2);
+        point_in_polygon_result res = point_in_polygon(*op, ring2);
         if (res != point_on_polygon) {
             return res == point_inside_polygon;
         }
         op = op->next;
     } while (op != outpt1);
-    point_in_polygon_result res = inside_or_outside_special(outpt1, outpt2);
+    point_in_polygon_result res = inside_or_outside_special(ring1, ring2);
     return res == point_inside_polygon;
 }
 } // namespace wagyu
@@ -9,11 +9,19 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
+/**
+ * The scanbeam queue holds the y values where the sweep has to stop, largest first. By
+ * default it is a sorted vector, which is fastest when few values are waiting at a time.
+ * Inserting into it is linear though, so for inputs with very many distinct y values
+ * USE_WAGYU_SCANBEAM_HEAP can be defined before including wagyu.hpp to keep the vector
+ * as a binary heap instead. The heap accepts duplicates and drops them when popped.
+ */
+
 template <typename T>
-using scanbeam_list = std::vector<T>;
+using scanbeam_list = std::vector<T, resource_allocator<T>>;
 
 template <typename T>
-void insert_sorted_scanbeam(scanbeam_list<T>& scanbeam, T& t) {
+void insert_scanbeam_sorted(scanbeam_list<T>& scanbeam, T t) {
     typename scanbeam_list<T>::iterator i = std::lower_bound(scanbeam.begin(), scanbeam.end(), t);
     if (i == scanbeam.end() || t < *i) {
         scanbeam.insert(i, t);
@@ -21,7 +29,7 @@ void insert_sorted_scanbeam(scanbeam_list<T>& scanbeam, T& t) {
 }
 
 template <typename T>
-bool pop_from_scanbeam(T& Y, scanbeam_list<T>& scanbeam) {
+bool pop_from_scanbeam_sorted(T& Y, scanbeam_list<T>& scanbeam) {
     if (scanbeam.empty()) {
         return false;
     }
@@ -32,7 +40,7 @@ bool pop_from_scanbeam(T& Y, scanbeam_list<T>& scanbeam) {
 }
 
 template <typename T>
-void setup_scanbeam(local_minimum_list<T>& minima_list, scanbeam_list<T>& scanbeam) {
+void setup_scanbeam_sorted(local_minimum_list<T>& minima_list, scanbeam_list<T>& scanbeam) {
 
     scanbeam.reserve(minima_list.size());
     for (auto lm = minima_list.begin(); lm != minima_list.end(); ++lm) {
@@ -40,6 +48,77 @@ void setup_scanbeam(local_minimum_list<T>& minima_list, scanbeam_list<T>& scanbe
     }
     std::sort(scanbeam.begin(), scanbeam.end());
 }
+
+template <typename T>
+void insert_scanbeam_heap(scanbeam_list<T>& scanbeam, T t) {
+    scanbeam.push_back(t);
+    std::push_heap(scanbeam.begin(), scanbeam.end());
+}
+
+template <typename T>
+bool pop_from_scanbeam_heap(T& Y, scanbeam_list<T>& scanbeam) {
+    if (scanbeam.empty()) {
+        return false;
+    }
+
+    Y = scanbeam.front();
+    do {
+        std::pop_heap(scanbeam.begin(), scanbeam.end());
+        scanbeam.pop_back();
+    } while (!scanbeam.empty() && scanbeam.front() == Y);
+    return true;
+}
+
+template <typename T>
+void setup_scanbeam_heap(local_minimum_list<T>& minima_list, scanbeam_list<T>& scanbeam) {
+
+    scanbeam.reserve(minima_list.size());
+    for (auto lm = minima_list.begin(); lm != minima_list.end(); ++lm) {
+        scanbeam.push_back(lm->y);
+    }
+    std::make_heap(scanbeam.begin(), scanbeam.end());
+}
+
+template <typename T>
+void insert_sorted_scanbeam(scanbeam_list<T>& scanbeam, T& t) {
+#ifdef USE_WAGYU_SCANBEAM_HEAP
+    insert_scanbeam_heap(scanbeam, t);
+#else
+    insert_scanbeam_sorted(scanbeam, t);
+#endif
+}
+
+template <typename T>
+bool pop_from_scanbeam(T& Y, scanbeam_list<T>& scanbeam) {
+#ifdef USE_WAGYU_SCANBEAM_HEAP
+    return pop_from_scanbeam_heap(Y, scanbeam);
+#else
+    return pop_from_scanbeam_sorted(Y, scanbeam);
+#endif
+}
+
+template <typename T>
+void setup_scanbeam(local_minimum_list<T>& minima_list, scanbeam_list<T>& scanbeam) {
+#ifdef USE_WAGYU_SCANBEAM_HEAP
+    setup_scanbeam_heap(minima_list, scanbeam);
+#else
+    setup_scanbeam_sorted(minima_list, scanbeam);
+#endif
+}
+
+// Sets up the scanbeam for a subset of the local minima, such as a single cluster
+template <typename T>
+void setup_scanbeam(local_minimum_ptr_list<T> const& minima, scanbeam_list<T>& scanbeam) {
+    scanbeam.reserve(minima.size());
+    for (auto const& lm : minima) {
+        scanbeam.push_back(lm->y);
+    }
+#ifdef USE_WAGYU_SCANBEAM_HEAP
+    std::make_heap(scanbeam.begin(), scanbeam.end());
+#else
+    std::sort(scanbeam.begin(), scanbeam.end());
+#endif
+}
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
@@ -1,14 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
 #include <mapbox/geometry/wagyu/active_bound_list.hpp>
 #include <mapbox/geometry/wagyu/bound.hpp>
-#include <mapbox/geometry/wagyu/bubble_sort.hpp>
+#include <mapbox/geometry/wagyu/cluster.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/crossing_sort.hpp>
 #include <mapbox/geometry/wagyu/edge.hpp>
 #include <mapbox/geometry/wagyu/intersect.hpp>
 #include <mapbox/geometry/wagyu/intersect_util.hpp>
+#include <mapbox/geometry/wagyu/local_minimum.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
+#include <mapbox/geometry/wagyu/scanbeam.hpp>
 #include <mapbox/geometry/wagyu/util.hpp>
 
 namespace mapbox {
@@ -39,9 +51,11 @@ void process_hot_pixel_intersections(T top_y, active_bound_list<T>& active_bound
     if (active_bounds.empty()) {
         return;
     }
-    update_current_x(active_bounds, top_y);
-    bubble_sort(active_bounds.begin(), active_bounds.end(), intersection_compare<T>(),
-                hp_intersection_swap<T>(manager));
+    if (!update_current_x(active_bounds, top_y)) {
+        return;
+    }
+    crossing_sort(active_bounds.begin(), active_bounds.end(), bound_current_x<T>(), intersection_compare<T>(),
+                  hp_intersection_swap<T>(manager), manager.crossing_method);
 }
 
 template <typename T>
@@ -62,7 +76,7 @@ bool horizontals_at_top_scanbeam(T top_y,
                 mapbox::geometry::point<T> pt(wround<T>((*bnd_next)->current_x), top_y);
                 add_to_hot_pixels(pt, manager);
             }
-            std::iter_swap(bnd_curr, bnd_next);
+            swap_bounds<T>(bnd_curr, bnd_next, active_bounds);
             ++bnd_curr;
             ++bnd_next;
             shifted = true;
@@ -78,7 +92,7 @@ bool horizontals_at_top_scanbeam(T top_y,
                     mapbox::geometry::point<T> pt(wround<T>((*bnd_prev)->current_x), top_y);
                     add_to_hot_pixels(pt, manager);
                 }
-                std::iter_swap(bnd_curr, bnd_prev);
+                swap_bounds<T>(bnd_curr, bnd_prev, active_bounds);
                 --bnd_curr;
                 if (bnd_curr != active_bounds.begin()) {
                     --bnd_prev;
@@ -119,7 +133,7 @@ void process_hot_pixel_edges_at_top_of_scanbeam(T top_y,
             ++bnd;
         }
     }
-    active_bounds.erase(std::remove(active_bounds.begin(), active_bounds.end(), nullptr), active_bounds.end());
+    remove_null_bounds(active_bounds);
 }
 
 template <typename T>
@@ -152,26 +166,20 @@ void insert_local_minima_into_ABL_hot_pixel(T top_y,
 }
 
 template <typename T>
-void build_hot_pixels(local_minimum_list<T>& minima_list, ring_manager<T>& manager) {
+void build_hot_pixels(local_minimum_ptr_list<T>& minima_sorted, ring_manager<T>& manager) {
     active_bound_list<T> active_bounds;
     scanbeam_list<T> scanbeam;
     T scanline_y = std::numeric_limits<T>::max();
 
-    local_minimum_ptr_list<T> minima_sorted;
-    minima_sorted.reserve(minima_list.size());
-    for (auto& lm : minima_list) {
-        minima_sorted.push_back(&lm);
-    }
-    std::stable_sort(minima_sorted.begin(), minima_sorted.end(), local_minimum_sorter<T>());
     local_minimum_ptr_list_itr<T> current_lm = minima_sorted.begin();
 
-    setup_scanbeam(minima_list, scanbeam);
+    setup_scanbeam(minima_sorted, scanbeam);
 
     // Estimate size for reserving hot pixels
     std::size_t reserve = 0;
-    for (auto& lm : minima_list) {
-        reserve += lm.left_bound.edges.size() + 2;
-        reserve += lm.right_bound.edges.size() + 2;
+    for (auto lm : minima_sorted) {
+        reserve += lm->left_bound.edges.size() + 2;
+        reserve += lm->right_bound.edges.size() + 2;
     }
     manager.hot_pixels.reserve(reserve);
 
@@ -186,6 +194,158 @@ void build_hot_pixels(local_minimum_list<T>& minima_list, ring_manager<T>& manag
     preallocate_point_memory(manager, manager.hot_pixels.size());
     sort_hot_pixels(manager);
 }
+
+template <typename T>
+void build_hot_pixels(local_minimum_list<T>& minima_list, ring_manager<T>& manager) {
+    build_hot_pixels(sort_local_minima(minima_list), manager);
+}
+
+/**
+ * The hot pixels end up sorted and without duplicates, so they can be found for horizontal bands
+ * of the input on their own and put together afterwards. The bands are cut at scanlines of the
+ * sweep. Each band starts with the active bound list the sweep has after the scanline it is cut at,
+ * made of copies of the bounds so that bands can run at the same time.
+ *
+ * That list is ordered by the x of each bound on the scanline and bounds with the same x by their
+ * slope, which is the order they had before the scanline. The sweep may order bounds that meet on
+ * the scanline differently only when one of them has a vertex there, and then the point where they
+ * meet is a hot pixel either way.
+ */
+
+// Fewest edges worth a band of its own
+constexpr std::size_t hot_pixel_band_min_edges = 4096;
+
+template <typename T>
+struct hot_pixel_band_sorter {
+    inline bool operator()(bound_ptr<T> const& b1, bound_ptr<T> const& b2) {
+        if (b1->current_x < b2->current_x) {
+            return true;
+        }
+        if (b2->current_x < b1->current_x) {
+            return false;
+        }
+        return b1->current_edge->dx < b2->current_edge->dx;
+    }
+};
+
+// Finds the hot pixels of the scanlines below cuts[band - 1] down to cuts[band]
+template <typename T>
+void build_hot_pixels_in_band(local_minimum_ptr_list<T> const& minima_sorted,
+                              std::vector<T, resource_allocator<T>> const& cuts,
+                              std::size_t band,
+                              ring_manager<T>& manager) {
+    std::deque<bound<T>, resource_allocator<bound<T>>> bounds;
+    std::deque<local_minimum<T>, resource_allocator<local_minimum<T>>> minima;
+    local_minimum_ptr_list<T> band_minima;
+    active_bound_list<T> active_bounds;
+    scanbeam_list<T> scanbeam;
+    bool last_band = band == cuts.size();
+    std::size_t reserve = 0;
+
+    auto lm = minima_sorted.begin();
+    if (band > 0) {
+        T above = cuts[band - 1];
+        for (; lm != minima_sorted.end() && (*lm)->y >= above; ++lm) {
+            for (auto original : { &(*lm)->left_bound, &(*lm)->right_bound }) {
+                if (original->edges.back().top.y >= above) {
+                    continue;
+                }
+                bounds.emplace_back();
+                auto& bnd = bounds.back();
+                bnd.edges = original->edges;
+                bnd.current_edge = std::partition_point(bnd.edges.begin(), bnd.edges.end(),
+                                                        [above](edge<T> const& e) { return e.top.y >= above; });
+                bnd.next_edge = std::next(bnd.current_edge);
+                bnd.current_x = get_current_x(*(bnd.current_edge), above);
+                active_bounds.push_back(&bnd);
+                reserve += static_cast<std::size_t>(std::distance(bnd.current_edge, bnd.edges.end())) + 2;
+            }
+        }
+        std::stable_sort(active_bounds.begin(), active_bounds.end(), hot_pixel_band_sorter<T>());
+        update_bound_positions(active_bounds, 0);
+    }
+    for (; lm != minima_sorted.end() && (last_band || (*lm)->y >= cuts[band]); ++lm) {
+        minima.emplace_back(bound<T>(), bound<T>(), (*lm)->y, (*lm)->minimum_has_horizontal);
+        minima.back().left_bound.edges = (*lm)->left_bound.edges;
+        minima.back().right_bound.edges = (*lm)->right_bound.edges;
+        band_minima.push_back(&minima.back());
+        reserve += (*lm)->left_bound.edges.size() + (*lm)->right_bound.edges.size() + 4;
+    }
+    manager.hot_pixels.reserve(reserve);
+
+    setup_scanbeam(band_minima, scanbeam);
+    for (auto bnd : active_bounds) {
+        T top_y = bnd->current_edge->top.y;
+        insert_sorted_scanbeam(scanbeam, top_y);
+    }
+    T scanline_y = std::numeric_limits<T>::max();
+    local_minimum_ptr_list_itr<T> current_lm = band_minima.begin();
+    while (pop_from_scanbeam(scanline_y, scanbeam) || current_lm != band_minima.end()) {
+        if (!last_band && scanline_y < cuts[band]) {
+            break;
+        }
+
+        process_hot_pixel_intersections(scanline_y, active_bounds, manager);
+
+        insert_local_minima_into_ABL_hot_pixel(scanline_y, band_minima, current_lm, active_bounds, manager, scanbeam);
+
+        process_hot_pixel_edges_at_top_of_scanbeam(scanline_y, scanbeam, active_bounds, manager);
+    }
+}
+
+// Same hot pixels as build_hot_pixels, found for up to `bands` bands on as many threads
+template <typename T>
+void build_hot_pixels_in_bands(local_minimum_ptr_list<T>& minima_sorted,
+                               ring_manager<T>& manager,
+                               std::size_t bands,
+                               memory_resource* resource) {
+    // Cut where the edge tops split evenly, every edge top is a scanline of the sweep
+    std::vector<T, resource_allocator<T>> tops(resource);
+    std::vector<T, resource_allocator<T>> cuts(resource);
+    for (auto lm : minima_sorted) {
+        for (auto const& e : lm->left_bound.edges) {
+            if (!is_horizontal(e)) {
+                tops.push_back(e.top.y);
+            }
+        }
+        for (auto const& e : lm->right_bound.edges) {
+            if (!is_horizontal(e)) {
+                tops.push_back(e.top.y);
+            }
+        }
+    }
+    for (std::size_t b = 1; b < bands && !tops.empty(); ++b) {
+        auto nth = tops.begin() + static_cast<std::ptrdiff_t>(tops.size() * b / bands);
+        std::nth_element(tops.begin(), nth, tops.end(), std::greater<T>());
+        if (cuts.empty() || *nth < cuts.back()) {
+            cuts.push_back(*nth);
+        }
+    }
+    if (cuts.empty()) {
+        build_hot_pixels(minima_sorted, manager);
+        return;
+    }
+
+    std::deque<ring_manager<T>, resource_allocator<ring_manager<T>>> band_managers(resource);
+    for (std::size_t b = 0; b <= cuts.size(); ++b) {
+        band_managers.emplace_back(resource);
+        band_managers.back().crossing_method = manager.crossing_method;
+    }
+    run_concurrently(band_managers.size(), bands, resource, [&](std::size_t b) {
+        build_hot_pixels_in_band(minima_sorted, cuts, b, band_managers[b]);
+    });
+    std::size_t size = 0;
+    for (auto const& band_manager : band_managers) {
+        size += band_manager.hot_pixels.size();
+    }
+    manager.hot_pixels.reserve(size);
+    for (auto const& band_manager : band_managers) {
+        manager.hot_pixels.insert(manager.hot_pixels.end(), band_manager.hot_pixels.begin(),
+                                  band_manager.hot_pixels.end());
+    }
+    preallocate_point_memory(manager, manager.hot_pixels.size());
+    sort_hot_pixels(manager, bands);
+}
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
@@ -4,13 +4,20 @@
 #include <cmath>
 
 #include <algorithm>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <map>
-#include <set>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <mapbox/geometry/wagyu/box_index.hpp>
+#include <mapbox/geometry/wagyu/cluster.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+#include <mapbox/geometry/wagyu/radix_sort.hpp>
 #include <mapbox/geometry/wagyu/ring.hpp>
 #include <mapbox/geometry/wagyu/ring_util.hpp>
 
@@ -43,53 +50,117 @@ struct point_ptr_pair {
     }
 };
 
+template <typename T>
+using point_ptr_pair_vector = std::vector<point_ptr_pair<T>, resource_allocator<point_ptr_pair<T>>>;
+
+template <typename T>
+using ring_connection_list = std::vector<std::pair<ring_ptr<T>, point_ptr_pair<T>>,
+                                         resource_allocator<std::pair<ring_ptr<T>, point_ptr_pair<T>>>>;
+
+// Rings seen by a search for a chain of connections, by ring_index. Clearing starts a new search
+// rather than touching every ring seen by the last one.
+template <typename T>
+struct ring_visited_set {
+    std::vector<std::size_t, resource_allocator<std::size_t>> searches;
+    std::size_t search;
+
+    ring_visited_set() : searches(), search(0) {
+    }
+
+    void clear(std::size_t ring_count) {
+        ++search;
+        if (searches.size() < ring_count) {
+            searches.resize(ring_count, 0);
+        }
+    }
+
+    void insert(ring_ptr<T> r) {
+        searches[r->ring_index] = search;
+    }
+
+    bool contains(ring_ptr<T> r) const {
+        return r->ring_index < searches.size() && searches[r->ring_index] == search;
+    }
+};
+
+// The connection point pairs of each ring with other rings, by ring_index. The connections of a
+// ring are added at the back and looked at from the back, so that they are visited newest first
+// as they were when this was an unordered_multimap.
+template <typename T>
+struct ring_connection_map {
+    std::vector<point_ptr_pair_vector<T>, resource_allocator<point_ptr_pair_vector<T>>> connections;
+    ring_visited_set<T> visited;
+
+    ring_connection_map() : connections(), visited() {
+    }
+
+    // Makes room for every ring, so that looking at connections during a search never
+    // moves the connections of the rings being searched
+    void reserve(std::size_t ring_count) {
+        if (connections.size() < ring_count) {
+            connections.resize(ring_count);
+        }
+    }
+
+    point_ptr_pair_vector<T>& operator[](ring_ptr<T> r) {
+        return connections[r->ring_index];
+    }
+
+    void add(ring_ptr<T> r, point_ptr_pair<T> const& pair) {
+        reserve(r->ring_index + 1);
+        connections[r->ring_index].push_back(pair);
+    }
+};
+
 #ifdef DEBUG
 
 template <class charT, class traits, typename T>
 inline std::basic_ostream<charT, traits>&
 operator<<(std::basic_ostream<charT, traits>& out,
-           const std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& dupe_ring) {
+           const ring_connection_map<T>& dupe_ring) {
 
     out << " BEGIN CONNECTIONS: " << std::endl;
-    for (auto& r : dupe_ring) {
-        out << "  Ring: ";
-        if (r.second.op1->ring) {
-            out << r.second.op1->ring->ring_index;
-        } else {
-            out << "---";
-        }
-        out << " to ";
-        if (r.second.op2->ring) {
-            out << r.second.op2->ring->ring_index;
-        } else {
-            out << "---";
-        }
-        out << "  ( at " << r.second.op1->x << ", " << r.second.op1->y << " )";
-        out << "  Ring1 ( ";
-        if (r.second.op1->ring) {
-            out << "area: " << r.second.op1->ring->area << " parent: ";
-            if (r.second.op1->ring->parent) {
-                out << r.second.op1->ring->parent->ring_index;
+    for (auto const& ring_connections : dupe_ring.connections) {
+        for (auto itr = ring_connections.rbegin(); itr != ring_connections.rend(); ++itr) {
+            out << "  Ring: ";
+            if (itr->op1->ring) {
+                out << itr->op1->ring->ring_index;
             } else {
                 out << "---";
             }
-        } else {
-            out << "---";
-        }
-        out << " )";
-        out << "  Ring2 ( ";
-        if (r.second.op2->ring) {
-            out << "area: " << r.second.op2->ring->area << " parent: ";
-            if (r.second.op2->ring->parent) {
-                out << r.second.op2->ring->parent->ring_index;
+            out << " to ";
+            if (itr->op2->ring) {
+                out << itr->op2->ring->ring_index;
             } else {
                 out << "---";
             }
-        } else {
-            out << "---";
+            out << "  ( at " << itr->op1->x << ", " << itr->op1->y << " )";
+            out << "  Ring1 ( ";
+            if (itr->op1->ring) {
+                out << "area: " << itr->op1->ring->area << " parent: ";
+                if (itr->op1->ring->parent) {
+                    out << itr->op1->ring->parent->ring_index;
+                } else {
+                    out << "---";
+                }
+            } else {
+                out << "---";
+            }
+            out << " )";
+            out << "  Ring2 ( ";
+            if (itr->op2->ring) {
+                out << "area: " << itr->op2->ring->area << " parent: ";
+                if (itr->op2->ring->parent) {
+                    out << itr->op2->ring->parent->ring_index;
+                } else {
+                    out << "---";
+                }
+            } else {
+                out << "---";
+            }
+            out << " )";
+            out << std::endl;
         }
-        out << " )";
-        out << std::endl;
     }
     out << " END CONNECTIONS: " << std::endl;
     return out;
@@ -98,46 +169,44 @@ operator<<(std::basic_ostream<charT, traits>& out,
 #endif
 
 template <typename T>
-bool find_intersect_loop(std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& dupe_ring,
-                         std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>>& iList,
+bool find_intersect_loop(ring_connection_map<T>& dupe_ring,
+                         ring_connection_list<T>& iList,
                          ring_ptr<T> ring_parent,
                          ring_ptr<T> ring_origin,
                          ring_ptr<T> ring_search,
-                         std::set<ring_ptr<T>>& visited,
+                         ring_visited_set<T>& visited,
                          point_ptr<T> orig_pt,
                          point_ptr<T> prev_pt,
                          ring_manager<T>& rings) {
-    {
-        auto range = dupe_ring.equal_range(ring_search);
-        // Check for direct connection
-        for (auto& it = range.first; it != range.second;) {
-            ring_ptr<T> it_ring1 = it->second.op1->ring;
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
-            if (!it_ring1 || !it_ring2 || it_ring1 != ring_search || (!it_ring1->is_hole() && !it_ring2->is_hole())) {
-                it = dupe_ring.erase(it);
-                continue;
-            }
-            if (it_ring2 == ring_origin && (ring_parent == it_ring2 || ring_parent == it_ring2->parent) &&
-                *prev_pt != *it->second.op2 && *orig_pt != *it->second.op2) {
-                iList.emplace_front(ring_search, it->second);
-                return true;
-            }
-            ++it;
+    // The path is built from its end as the search returns
+    auto& connections = dupe_ring[ring_search];
+    // Check for direct connection
+    for (std::size_t i = connections.size(); i-- > 0;) {
+        ring_ptr<T> it_ring1 = connections[i].op1->ring;
+        ring_ptr<T> it_ring2 = connections[i].op2->ring;
+        if (!it_ring1 || !it_ring2 || it_ring1 != ring_search || (!it_ring1->is_hole() && !it_ring2->is_hole())) {
+            connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        if (it_ring2 == ring_origin && (ring_parent == it_ring2 || ring_parent == it_ring2->parent) &&
+            *prev_pt != *connections[i].op2 && *orig_pt != *connections[i].op2) {
+            iList.emplace_back(ring_search, connections[i]);
+            return true;
         }
     }
-    auto range = dupe_ring.equal_range(ring_search);
     visited.insert(ring_search);
-    // Check for connection through chain of other intersections
-    for (auto& it = range.first; it != range.second && it != dupe_ring.end() && it->first == ring_search; ++it) {
-        ring_ptr<T> it_ring = it->second.op2->ring;
-        if (visited.count(it_ring) > 0 || it_ring == nullptr ||
+    // Check for connection through chain of other intersections, which only ever
+    // changes the connections of other rings
+    for (std::size_t i = connections.size(); i-- > 0;) {
+        ring_ptr<T> it_ring = connections[i].op2->ring;
+        if (it_ring == nullptr || visited.contains(it_ring) ||
             (ring_parent != it_ring && ring_parent != it_ring->parent) || value_is_zero(it_ring->area()) ||
-            *prev_pt == *it->second.op2) {
+            *prev_pt == *connections[i].op2) {
             continue;
         }
-        if (find_intersect_loop(dupe_ring, iList, ring_parent, ring_origin, it_ring, visited, orig_pt, it->second.op2,
-                                rings)) {
-            iList.emplace_front(ring_search, it->second);
+        if (find_intersect_loop(dupe_ring, iList, ring_parent, ring_origin, it_ring, visited, orig_pt,
+                                connections[i].op2, rings)) {
+            iList.emplace_back(ring_search, connections[i]);
             return true;
         }
     }
@@ -159,20 +228,106 @@ struct point_ptr_cmp {
     }
 };
 
+template <typename T>
+void sort_all_points(ring_manager<T>& manager, std::size_t, std::false_type) {
+    std::stable_sort(manager.all_points.begin(), manager.all_points.end(), point_ptr_cmp<T>());
+}
+
+template <typename T>
+using keyed_point = std::pair<std::uint64_t, point_ptr<T>>;
+
+template <typename T>
+using keyed_point_vector = std::vector<keyed_point<T>, resource_allocator<keyed_point<T>>>;
+
+// Sorts the points by the keys worked out once for each, keeping the order of equal keys
+template <typename T, typename Key>
+void sort_points_by(point_vector<T>& points,
+                    keyed_point_vector<T>& keyed,
+                    Key key,
+                    std::size_t bits,
+                    std::size_t threads) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keyed[i] = keyed_point<T>(key(points[i]), points[i]);
+    }
+    radix_sort(keyed, [](keyed_point<T> const& kp) { return kp.first; }, bits, threads);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points[i] = keyed[i].second;
+    }
+}
+
+// Same order as point_ptr_cmp. The points are sorted along with their keys, so that the keys are
+// only worked out once for each sort.
+template <typename T>
+void sort_all_points(ring_manager<T>& manager, std::size_t threads, std::true_type) {
+    auto& points = manager.all_points;
+    std::size_t n = points.size();
+    if (n < radix_sort_min_size) {
+        sort_all_points(manager, threads, std::false_type());
+        return;
+    }
+    T min_y = points.front()->y;
+    T max_y = min_y;
+    T min_x = points.front()->x;
+    T max_x = min_x;
+    std::size_t max_depth = 0;
+    for (auto const& op : points) {
+        min_y = std::min(min_y, op->y);
+        max_y = std::max(max_y, op->y);
+        min_x = std::min(min_x, op->x);
+        max_x = std::max(max_x, op->x);
+        max_depth = std::max(max_depth, ring_depth(op->ring));
+    }
+    std::size_t y_bits = radix_key_bits(radix_key_descending(min_y, max_y));
+    std::size_t x_bits = radix_key_bits(radix_key_ascending(max_x, min_x));
+    std::size_t depth_bits = radix_key_bits(max_depth);
+    auto y_key = [max_y](point_ptr<T> op) { return radix_key_descending(op->y, max_y); };
+    auto x_key = [min_x](point_ptr<T> op) { return radix_key_ascending(op->x, min_x); };
+    auto depth_key = [max_depth](point_ptr<T> op) { return radix_key_descending(ring_depth(op->ring), max_depth); };
+
+    keyed_point_vector<T> keyed(n);
+    if (y_bits + x_bits + depth_bits <= 64) {
+        sort_points_by(
+            points, keyed,
+            [&](point_ptr<T> op) {
+                return radix_key_pack(radix_key_pack(y_key(op), x_key(op), x_bits), depth_key(op), depth_bits);
+            },
+            y_bits + x_bits + depth_bits, threads);
+        return;
+    }
+    if (x_bits + depth_bits <= 64) {
+        sort_points_by(
+            points, keyed, [&](point_ptr<T> op) { return radix_key_pack(x_key(op), depth_key(op), depth_bits); },
+            x_bits + depth_bits, threads);
+    } else {
+        sort_points_by(points, keyed, depth_key, depth_bits, threads);
+        sort_points_by(points, keyed, x_key, x_bits, threads);
+    }
+    sort_points_by(points, keyed, y_key, y_bits, threads);
+}
+
 template <typename T>
 void correct_orientations(ring_manager<T>& manager) {
-    for (auto& r : manager.rings) {
-        if (!r.points) {
+    for (std::size_t i = 0; i < manager.index; ++i) {
+        ring_ptr<T> r = &manager.rings[i];
+        if (!r->points) {
             continue;
         }
-        r.recalculate_stats();
-        if (r.size() < 3) {
-            remove_ring_and_points(&r, manager, false);
+        // Stats kept up to date by the sweep are exact
+        bool exact = r->stats_known();
+        if (!exact) {
+            r->recalculate_stats();
+        }
+        if (r->size() < 3) {
+            remove_ring_and_points(r, manager, false);
             continue;
         }
-        if (ring_is_hole(&r) != r.is_hole()) {
-            reverse_ring(r.points);
-            r.recalculate_stats();
+        if (ring_is_hole(r) != r->is_hole()) {
+            reverse_ring(r->points);
+            if (exact) {
+                r->set_stats(-r->area(), r->size(), r->bbox);
+            } else {
+                r->recalculate_stats();
+            }
         }
     }
 }
@@ -257,8 +412,25 @@ void correct_repeated_points(ring_manager<T>& manager,
 }
 
 template <typename T>
-void find_and_correct_repeated_points(ring_ptr<T> r, ring_manager<T>& manager, ring_vector<T>& new_rings) {
-    auto sorted_points = sort_ring_points(r);
+bool has_repeated_points(point_vector<T> const& sorted_points) {
+    if (sorted_points.size() < 2) {
+        return false;
+    }
+    for (auto itr = std::next(sorted_points.begin()); itr != sorted_points.end(); ++itr) {
+        if (*(*std::prev(itr)) == *(*itr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void find_and_correct_repeated_points(point_vector<T>& sorted_points,
+                                      ring_manager<T>& manager,
+                                      ring_vector<T>& new_rings) {
+    if (sorted_points.empty()) {
+        return;
+    }
     // Find sets of repeated points
     std::size_t count = 0;
     auto prev_itr = sorted_points.begin();
@@ -287,6 +459,12 @@ void find_and_correct_repeated_points(ring_ptr<T> r, ring_manager<T>& manager, r
     }
 }
 
+template <typename T>
+void find_and_correct_repeated_points(ring_ptr<T> r, ring_manager<T>& manager, ring_vector<T>& new_rings) {
+    auto sorted_points = sort_ring_points(r);
+    find_and_correct_repeated_points(sorted_points, manager, new_rings);
+}
+
 template <typename T>
 void reassign_children_if_necessary(ring_ptr<T> new_ring,
                                     ring_ptr<T> sibling_ring,
@@ -450,7 +628,10 @@ void assign_new_ring_parents(ring_manager<T>& manager, ring_ptr<T> original_ring
 }
 
 template <typename T>
-bool correct_ring_self_intersections(ring_manager<T>& manager, ring_ptr<T> r, bool correct_tree) {
+bool correct_ring_self_intersections(ring_manager<T>& manager,
+                                     ring_ptr<T> r,
+                                     point_vector<T>& sorted_points,
+                                     bool correct_tree) {
 
     if (r->corrected || !r->points) {
         return false;
@@ -458,7 +639,7 @@ bool correct_ring_self_intersections(ring_manager<T>& manager, ring_ptr<T> r, bo
 
     ring_vector<T> new_rings;
 
-    find_and_correct_repeated_points(r, manager, new_rings);
+    find_and_correct_repeated_points(sorted_points, manager, new_rings);
 
     if (correct_tree) {
         assign_new_ring_parents(manager, r, new_rings);
@@ -469,7 +650,16 @@ bool correct_ring_self_intersections(ring_manager<T>& manager, ring_ptr<T> r, bo
 }
 
 template <typename T>
-void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& connection_map,
+bool correct_ring_self_intersections(ring_manager<T>& manager, ring_ptr<T> r, bool correct_tree) {
+    if (r->corrected || !r->points) {
+        return false;
+    }
+    auto sorted_points = sort_ring_points(r);
+    return correct_ring_self_intersections(manager, r, sorted_points, correct_tree);
+}
+
+template <typename T>
+void process_single_intersection(ring_connection_map<T>& connection_map,
                                  point_ptr<T> op_j,
                                  point_ptr<T> op_k,
                                  ring_manager<T>& manager) {
@@ -517,53 +707,52 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         return;
     }
     bool found = false;
-    std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>> iList;
+    ring_connection_list<T> iList;
+    connection_map.reserve(manager.index);
     {
-        auto range = connection_map.equal_range(ring_search);
+        auto& connections = connection_map[ring_search];
         // Check for direct connection
-        for (auto& it = range.first; it != range.second;) {
-            if (!it->second.op1->ring) {
-                it = connection_map.erase(it);
+        for (std::size_t i = connections.size(); i-- > 0;) {
+            if (!connections[i].op1->ring) {
+                connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i));
                 continue;
             }
-            if (!it->second.op2->ring) {
-                it = connection_map.erase(it);
+            if (!connections[i].op2->ring) {
+                connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i));
                 continue;
             }
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
+            ring_ptr<T> it_ring2 = connections[i].op2->ring;
             if (it_ring2 == ring_origin) {
                 found = true;
-                if (*op_origin_1 != *(it->second.op2)) {
-                    iList.emplace_back(ring_search, it->second);
+                if (*op_origin_1 != *(connections[i].op2)) {
+                    iList.emplace_back(ring_search, connections[i]);
                     break;
                 }
             }
-            ++it;
         }
     }
     if (iList.empty()) {
-        auto range = connection_map.equal_range(ring_search);
-        std::set<ring_ptr<T>> visited;
+        auto& connections = connection_map[ring_search];
+        ring_visited_set<T>& visited = connection_map.visited;
+        visited.clear(manager.index);
         visited.insert(ring_search);
         // Check for connection through chain of other intersections
-        for (auto& it = range.first; it != range.second && it != connection_map.end() && it->first == ring_search;
-             ++it) {
-            ring_ptr<T> it_ring = it->second.op2->ring;
-            if (it_ring != ring_search && *op_origin_2 != *it->second.op2 && it_ring != nullptr &&
+        for (std::size_t i = connections.size(); i-- > 0;) {
+            ring_ptr<T> it_ring = connections[i].op2->ring;
+            if (it_ring != ring_search && *op_origin_2 != *connections[i].op2 && it_ring != nullptr &&
                 (ring_parent == it_ring || ring_parent == it_ring->parent) && !value_is_zero(it_ring->area()) &&
                 find_intersect_loop(connection_map, iList, ring_parent, ring_origin, it_ring, visited, op_origin_2,
-                                    it->second.op2, manager)) {
+                                    connections[i].op2, manager)) {
                 found = true;
-                iList.emplace_front(ring_search, it->second);
+                iList.emplace_back(ring_search, connections[i]);
+                std::reverse(iList.begin(), iList.end());
                 break;
             }
         }
     }
     if (!found) {
-        point_ptr_pair<T> intPt_origin = { op_origin_1, op_origin_2 };
-        point_ptr_pair<T> intPt_search = { op_origin_2, op_origin_1 };
-        connection_map.emplace(ring_origin, std::move(intPt_origin));
-        connection_map.emplace(ring_search, std::move(intPt_search));
+        connection_map.add(ring_origin, point_ptr_pair<T>(op_origin_1, op_origin_2));
+        connection_map.add(ring_search, point_ptr_pair<T>(op_origin_2, op_origin_1));
         return;
     }
 
@@ -571,17 +760,15 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         // The situation where both origin and search are holes might have a missing
         // search condition, we must check if a new pair must be added.
         bool missing = true;
-        auto rng = connection_map.equal_range(ring_origin);
         // Check for direct connection
-        for (auto& it = rng.first; it != rng.second; ++it) {
-            ring_ptr<T> it_ring2 = it->second.op2->ring;
+        for (auto const& connection : connection_map[ring_origin]) {
+            ring_ptr<T> it_ring2 = connection.op2->ring;
             if (it_ring2 == ring_search) {
                 missing = false;
             }
         }
         if (missing) {
-            point_ptr_pair<T> intPt_origin = { op_origin_1, op_origin_2 };
-            connection_map.emplace(ring_origin, std::move(intPt_origin));
+            connection_map.add(ring_origin, point_ptr_pair<T>(op_origin_1, op_origin_2));
         }
         return;
     }
@@ -685,49 +872,44 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
         }
     }
 
-    std::list<std::pair<ring_ptr<T>, point_ptr_pair<T>>> move_list;
+    ring_connection_list<T> move_list;
 
     for (auto& iRing : iList) {
-        auto range_itr = connection_map.equal_range(iRing.first);
-        if (range_itr.first != range_itr.second) {
-            for (auto& it = range_itr.first; it != range_itr.second; ++it) {
-                ring_ptr<T> it_ring = it->second.op1->ring;
-                ring_ptr<T> it_ring2 = it->second.op2->ring;
-                if (it_ring == nullptr || it_ring2 == nullptr || it_ring == it_ring2) {
-                    continue;
-                }
-                if (it_ring->is_hole() || it_ring2->is_hole()) {
-                    move_list.emplace_back(it_ring, it->second);
-                }
+        auto& connections = connection_map[iRing.first];
+        for (std::size_t i = connections.size(); i-- > 0;) {
+            ring_ptr<T> it_ring = connections[i].op1->ring;
+            ring_ptr<T> it_ring2 = connections[i].op2->ring;
+            if (it_ring == nullptr || it_ring2 == nullptr || it_ring == it_ring2) {
+                continue;
+            }
+            if (it_ring->is_hole() || it_ring2->is_hole()) {
+                move_list.emplace_back(it_ring, connections[i]);
             }
-            connection_map.erase(iRing.first);
         }
+        connections.clear();
     }
 
-    auto range_itr = connection_map.equal_range(ring_origin);
-    for (auto& it = range_itr.first; it != range_itr.second;) {
-        ring_ptr<T> it_ring = it->second.op1->ring;
-        ring_ptr<T> it_ring2 = it->second.op2->ring;
+    auto& origin_connections = connection_map[ring_origin];
+    for (std::size_t i = origin_connections.size(); i-- > 0;) {
+        auto it = origin_connections.begin() + static_cast<std::ptrdiff_t>(i);
+        ring_ptr<T> it_ring = it->op1->ring;
+        ring_ptr<T> it_ring2 = it->op2->ring;
         if (it_ring == nullptr || it_ring2 == nullptr || it_ring == it_ring2) {
-            it = connection_map.erase(it);
+            origin_connections.erase(it);
             continue;
         }
         if (it_ring != ring_origin) {
             if (it_ring->is_hole() || it_ring2->is_hole()) {
-                move_list.emplace_back(it_ring, it->second);
-            }
-            it = connection_map.erase(it);
-        } else {
-            if (it_ring->is_hole() || it_ring2->is_hole()) {
-                ++it;
-            } else {
-                it = connection_map.erase(it);
+                move_list.emplace_back(it_ring, *it);
             }
+            origin_connections.erase(it);
+        } else if (!it_ring->is_hole() && !it_ring2->is_hole()) {
+            origin_connections.erase(it);
         }
     }
 
-    if (!move_list.empty()) {
-        connection_map.insert(move_list.begin(), move_list.end());
+    for (auto const& move : move_list) {
+        connection_map.add(move.first, move.second);
     }
 
     return;
@@ -735,7 +917,7 @@ void process_single_intersection(std::unordered_multimap<ring_ptr<T>, point_ptr_
 
 template <typename T>
 void correct_chained_repeats(ring_manager<T>& manager,
-                             std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>>& connection_map,
+                             ring_connection_map<T>& connection_map,
                              point_vector_itr<T> const& begin,
                              point_vector_itr<T> const& end) {
     for (auto itr1 = begin; itr1 != end; ++itr1) {
@@ -759,8 +941,8 @@ void correct_chained_rings(ring_manager<T>& manager) {
     }
     // Setup connection map which is a map of rings and their
     // connection point pairs with other rings.
-    std::unordered_multimap<ring_ptr<T>, point_ptr_pair<T>> connection_map;
-    connection_map.reserve(manager.rings.size());
+    ring_connection_map<T> connection_map;
+    connection_map.reserve(manager.index);
 
     // Now lets find and process any points
     // that overlap -- we should have solved
@@ -798,9 +980,9 @@ void correct_chained_rings(ring_manager<T>& manager) {
 template <typename T>
 ring_vector<T> sort_rings_largest_to_smallest(ring_manager<T>& manager) {
     ring_vector<T> sorted_rings;
-    sorted_rings.reserve(manager.rings.size());
-    for (auto& r : manager.rings) {
-        sorted_rings.push_back(&r);
+    sorted_rings.reserve(manager.index);
+    for (std::size_t i = 0; i < manager.index; ++i) {
+        sorted_rings.push_back(&manager.rings[i]);
     }
     std::stable_sort(sorted_rings.begin(), sorted_rings.end(), [](ring_ptr<T> const& r1, ring_ptr<T> const& r2) {
         if (!r1->points || !r2->points) {
@@ -814,9 +996,9 @@ ring_vector<T> sort_rings_largest_to_smallest(ring_manager<T>& manager) {
 template <typename T>
 ring_vector<T> sort_rings_smallest_to_largest(ring_manager<T>& manager) {
     ring_vector<T> sorted_rings;
-    sorted_rings.reserve(manager.rings.size());
-    for (auto& r : manager.rings) {
-        sorted_rings.push_back(&r);
+    sorted_rings.reserve(manager.index);
+    for (std::size_t i = 0; i < manager.index; ++i) {
+        sorted_rings.push_back(&manager.rings[i]);
     }
     std::stable_sort(sorted_rings.begin(), sorted_rings.end(), [](ring_ptr<T> const& r1, ring_ptr<T> const& r2) {
         if (!r1->points || !r2->points) {
@@ -1258,6 +1440,9 @@ void correct_collinear_edges(ring_manager<T>& manager) {
     }
 }
 
+// Fewest rings for which correct_tree searches parents with a box index
+constexpr std::size_t ring_box_index_min_rings = 64;
+
 template <typename T>
 void correct_tree(ring_manager<T>& manager) {
 
@@ -1271,6 +1456,22 @@ void correct_tree(ring_manager<T>& manager) {
     // as we iterate over the rings.
     using rev_itr = typename ring_vector<T>::reverse_iterator;
     ring_vector<T> sorted_rings = sort_rings_largest_to_smallest(manager);
+
+    // With many rings only those whose box contains the box of the ring are
+    // looked at, still from the nearest in size to the largest. A ring
+    // removed below loses its box and could never have been a parent.
+    box_index<T> index;
+    std::vector<std::size_t, resource_allocator<std::size_t>> candidates;
+    bool use_index = sorted_rings.size() >= ring_box_index_min_rings;
+    if (use_index) {
+        std::vector<mapbox::geometry::box<T>, resource_allocator<mapbox::geometry::box<T>>> boxes;
+        boxes.reserve(sorted_rings.size());
+        for (auto const& r : sorted_rings) {
+            boxes.push_back(r->bbox);
+        }
+        build_box_index(index, boxes);
+    }
+
     for (auto itr = sorted_rings.begin(); itr != sorted_rings.end(); ++itr) {
         if ((*itr)->points == nullptr) {
             continue;
@@ -1281,17 +1482,35 @@ void correct_tree(ring_manager<T>& manager) {
         }
         (*itr)->corrected = true;
         bool found = false;
-        // Search in reverse from the current iterator back to the begining
-        // to see if any of those rings might be its parent.
-        for (auto r_itr = rev_itr(itr); r_itr != sorted_rings.rend(); ++r_itr) {
-            // If orientations are not different, this can't be its parent.
-            if ((*r_itr)->is_hole() == (*itr)->is_hole()) {
-                continue;
+        if (use_index) {
+            candidates.clear();
+            std::size_t limit = static_cast<std::size_t>(std::distance(sorted_rings.begin(), itr));
+            find_boxes_containing(index, (*itr)->bbox, limit, [&candidates](std::size_t i) { candidates.push_back(i); });
+            std::sort(candidates.begin(), candidates.end(), std::greater<std::size_t>());
+            for (auto i : candidates) {
+                ring_ptr<T> r = sorted_rings[i];
+                if (r->is_hole() == (*itr)->is_hole()) {
+                    continue;
+                }
+                if (poly2_contains_poly1(*itr, r)) {
+                    reassign_as_child(*itr, r, manager);
+                    found = true;
+                    break;
+                }
             }
-            if (poly2_contains_poly1(*itr, *r_itr)) {
-                reassign_as_child(*itr, *r_itr, manager);
-                found = true;
-                break;
+        } else {
+            // Search in reverse from the current iterator back to the begining
+            // to see if any of those rings might be its parent.
+            for (auto r_itr = rev_itr(itr); r_itr != sorted_rings.rend(); ++r_itr) {
+                // If orientations are not different, this can't be its parent.
+                if ((*r_itr)->is_hole() == (*itr)->is_hole()) {
+                    continue;
+                }
+                if (poly2_contains_poly1(*itr, *r_itr)) {
+                    reassign_as_child(*itr, *r_itr, manager);
+                    found = true;
+                    break;
+                }
             }
         }
         if (!found) {
@@ -1317,30 +1536,188 @@ bool correct_self_intersections(ring_manager<T>& manager, bool correct_tree) {
     return fixed_intersections;
 }
 
+/**
+ * Finding the repeated points of a ring only reads that ring, as every point belongs to a single
+ * ring. With more than one thread the points of all rings are sorted and checked for repeats
+ * concurrently first. Only the rings with repeated points are then corrected, one after another
+ * in the same order as above, so that new rings are created and put in the tree exactly as they
+ * would be on a single thread.
+ */
+
+template <typename T>
+bool correct_self_intersections(ring_manager<T>& manager, bool correct_tree, std::size_t threads) {
+    if (threads < 2) {
+        return correct_self_intersections(manager, correct_tree);
+    }
+    bool fixed_intersections = false;
+    auto sorted_rings = sort_rings_smallest_to_largest(manager);
+    std::vector<point_vector<T>, resource_allocator<point_vector<T>>> repeated_points(sorted_rings.size());
+    run_concurrently(sorted_rings.size(), threads, current_resource(), [&](std::size_t i) {
+        ring_ptr<T> r = sorted_rings[i];
+        manager.bind_pools();
+        if (r->corrected || !r->points) {
+            return;
+        }
+        auto sorted_points = sort_ring_points(r);
+        if (has_repeated_points(sorted_points)) {
+            repeated_points[i] = std::move(sorted_points);
+        }
+    });
+    for (std::size_t i = 0; i < sorted_rings.size(); ++i) {
+        if (correct_ring_self_intersections(manager, sorted_rings[i], repeated_points[i], correct_tree)) {
+            fixed_intersections = true;
+        }
+    }
+    return fixed_intersections;
+}
+
+// Whether any two points of the rings left share their coordinates, the points being sorted
+template <typename T>
+bool has_repeated_ring_points(point_vector<T> const& sorted_points) {
+    point_ptr<T> last = nullptr;
+    for (auto const& op : sorted_points) {
+        if (op->ring == nullptr) {
+            continue;
+        }
+        if (last != nullptr && *last == *op) {
+            return true;
+        }
+        last = op;
+    }
+    return false;
+}
+
+// Returns the topology_phase bits of the phases that ran
 template <typename T>
-void correct_topology(ring_manager<T>& manager) {
+std::uint8_t correct_topology(ring_manager<T>& manager, std::size_t threads) {
 
     // Sort all the points, this will be used for the locating of chained rings
     // and the collinear edges and only needs to be done once.
-    std::stable_sort(manager.all_points.begin(), manager.all_points.end(), point_ptr_cmp<T>());
+    sort_all_points(manager, threads, std::is_integral<T>());
 
     // Initially the orientations of the rings
     // could be incorrect, we need to adjust them
     correct_orientations(manager);
+    std::uint8_t phases = topology_phase_orientations;
+
+    // Collinear edges, self intersections and chained rings are all found
+    // at points shared by more than one point of the rings. Without any,
+    // those phases would only walk the points and rings to find nothing.
+    bool repeated_points = has_repeated_ring_points(manager.all_points);
 
-    // We should only have to fix collinear edges once.
-    // During this we also correct self intersections
-    correct_collinear_edges(manager);
+    if (repeated_points) {
+        // We should only have to fix collinear edges once.
+        // During this we also correct self intersections
+        correct_collinear_edges(manager);
 
-    correct_self_intersections(manager, false);
+        correct_self_intersections(manager, false, threads);
+        phases |= topology_phase_collinear_edges | topology_phase_self_intersections;
+    }
 
     correct_tree(manager);
+    phases |= topology_phase_tree;
+
+    if (repeated_points) {
+        bool fixed_intersections = true;
+        while (fixed_intersections) {
+            correct_chained_rings(manager);
+            fixed_intersections = correct_self_intersections(manager, true, threads);
+        }
+        phases |= topology_phase_chained_rings;
+    }
+    return phases;
+}
+
+template <typename T>
+std::uint8_t correct_topology(ring_manager<T>& manager) {
+    return correct_topology(manager, 1);
+}
+
+/**
+ * Output that is only ever drawn with an even-odd fill does not need rings that touch to be split
+ * or holes to be nested exactly. Once orientations and collinear edges are corrected the rings
+ * are put in a flat tree instead: every outer ring at the top, islands included, and every hole
+ * under the outer ring it was found in during the sweep. A hole whose outer ring is gone is put
+ * under the smallest outer ring whose box contains its box, or failing that reversed and put at
+ * the top, so that no ring is lost.
+ */
 
-    bool fixed_intersections = true;
-    while (fixed_intersections) {
-        correct_chained_rings(manager);
-        fixed_intersections = correct_self_intersections(manager, true);
+template <typename T>
+void flatten_tree(ring_manager<T>& manager) {
+    ring_vector<T> outers;
+    ring_vector<T> holes;
+    for (std::size_t i = 0; i < manager.index; ++i) {
+        ring_ptr<T> r = &manager.rings[i];
+        if (r->points && (r->size() < 3 || value_is_zero(r->area()))) {
+            remove_ring_and_points(r, manager, false);
+        }
+    }
+    for (std::size_t i = 0; i < manager.index; ++i) {
+        ring_ptr<T> r = &manager.rings[i];
+        if (!r->points) {
+            continue;
+        }
+        r->children.clear();
+        r->corrected = true;
+        if (r->is_hole()) {
+            holes.push_back(r);
+        } else {
+            outers.push_back(r);
+        }
+    }
+    manager.children.clear();
+    for (auto& r : outers) {
+        r->parent = nullptr;
+        manager.children.push_back(r);
     }
+
+    box_index<T> index;
+    for (auto& r : holes) {
+        ring_ptr<T> parent = r->parent;
+        if (parent != nullptr && parent->points && !parent->is_hole()) {
+            parent->children.push_back(r);
+            continue;
+        }
+        if (index.boxes.empty()) {
+            std::vector<mapbox::geometry::box<T>, resource_allocator<mapbox::geometry::box<T>>> boxes;
+            boxes.reserve(outers.size());
+            for (auto const& o : outers) {
+                boxes.push_back(o->bbox);
+            }
+            build_box_index(index, boxes);
+        }
+        parent = nullptr;
+        find_boxes_containing(index, r->bbox, outers.size(), [&](std::size_t i) {
+            if (parent == nullptr || std::fabs(outers[i]->area()) < std::fabs(parent->area())) {
+                parent = outers[i];
+            }
+        });
+        r->parent = parent;
+        if (parent != nullptr) {
+            parent->children.push_back(r);
+        } else {
+            reverse_ring(r->points);
+            r->set_stats(-r->area(), r->size(), r->bbox);
+            manager.children.push_back(r);
+        }
+    }
+}
+
+// Returns the topology_phase bits of the phases that ran, see flatten_tree
+template <typename T>
+std::uint8_t correct_topology_for_rendering(ring_manager<T>& manager, std::size_t threads) {
+    sort_all_points(manager, threads, std::is_integral<T>());
+
+    correct_orientations(manager);
+    std::uint8_t phases = topology_phase_orientations;
+
+    if (has_repeated_ring_points(manager.all_points)) {
+        correct_collinear_edges(manager);
+        phases |= topology_phase_collinear_edges;
+    }
+
+    flatten_tree(manager);
+    return phases;
 }
 } // namespace wagyu
 } // namespace geometry
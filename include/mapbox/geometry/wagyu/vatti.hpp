@@ -18,26 +18,20 @@ namespace mapbox {
 namespace geometry {
 namespace wagyu {
 
-template <typename T>
-void execute_vatti(local_minimum_list<T>& minima_list,
-                   ring_manager<T>& manager,
-                   clip_type cliptype,
-                   fill_type subject_fill_type,
-                   fill_type clip_fill_type) {
+template <typename T, typename Clip, typename SubjectFill, typename ClipFill>
+void vatti_sweep(local_minimum_ptr_list<T>& minima_sorted,
+                 ring_manager<T>& manager,
+                 Clip cliptype,
+                 SubjectFill subject_fill_type,
+                 ClipFill clip_fill_type) {
     active_bound_list<T> active_bounds;
     scanbeam_list<T> scanbeam;
     T scanline_y = std::numeric_limits<T>::max();
 
-    local_minimum_ptr_list<T> minima_sorted;
-    minima_sorted.reserve(minima_list.size());
-    for (auto& lm : minima_list) {
-        minima_sorted.push_back(&lm);
-    }
-    std::stable_sort(minima_sorted.begin(), minima_sorted.end(), local_minimum_sorter<T>());
     local_minimum_ptr_list_itr<T> current_lm = minima_sorted.begin();
     // std::clog << output_all_edges(minima_sorted) << std::endl;
 
-    setup_scanbeam(minima_list, scanbeam);
+    setup_scanbeam(minima_sorted, scanbeam);
     manager.current_hp_itr = manager.hot_pixels.begin();
 
     while (pop_from_scanbeam(scanline_y, scanbeam) || current_lm != minima_sorted.end()) {
@@ -59,6 +53,36 @@ void execute_vatti(local_minimum_list<T>& minima_list,
                                      subject_fill_type, clip_fill_type);
     }
 }
+
+template <typename T>
+void execute_vatti(local_minimum_ptr_list<T>& minima_sorted,
+                   ring_manager<T>& manager,
+                   clip_type cliptype,
+                   fill_type subject_fill_type,
+                   fill_type clip_fill_type) {
+    // The most common operations get their own copy of the sweep with the clip and fill
+    // types fixed at compile time, everything else shares the generic one.
+    if (cliptype == clip_type_union && subject_fill_type == fill_type_even_odd &&
+        clip_fill_type == fill_type_even_odd) {
+        vatti_sweep(minima_sorted, manager, clip_type_constant<clip_type_union>(),
+                    fill_type_constant<fill_type_even_odd>(), fill_type_constant<fill_type_even_odd>());
+    } else if (cliptype == clip_type_intersection && subject_fill_type == fill_type_non_zero &&
+               clip_fill_type == fill_type_non_zero) {
+        vatti_sweep(minima_sorted, manager, clip_type_constant<clip_type_intersection>(),
+                    fill_type_constant<fill_type_non_zero>(), fill_type_constant<fill_type_non_zero>());
+    } else {
+        vatti_sweep(minima_sorted, manager, cliptype, subject_fill_type, clip_fill_type);
+    }
+}
+
+template <typename T>
+void execute_vatti(local_minimum_list<T>& minima_list,
+                   ring_manager<T>& manager,
+                   clip_type cliptype,
+                   fill_type subject_fill_type,
+                   fill_type clip_fill_type) {
+    execute_vatti(sort_local_minima(minima_list), manager, cliptype, subject_fill_type, clip_fill_type);
+}
 } // namespace wagyu
 } // namespace geometry
 } // namespace mapbox
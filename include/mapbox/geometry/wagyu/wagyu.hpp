@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <list>
+#include <vector>
 
 #include <mapbox/geometry/box.hpp>
 #include <mapbox/geometry/line_string.hpp>
@@ -9,9 +13,14 @@
 
 #include <mapbox/geometry/wagyu/build_local_minima_list.hpp>
 #include <mapbox/geometry/wagyu/build_result.hpp>
+#include <mapbox/geometry/wagyu/cluster.hpp>
 #include <mapbox/geometry/wagyu/config.hpp>
+#include <mapbox/geometry/wagyu/flat_multi_polygon.hpp>
+#include <mapbox/geometry/wagyu/interleaved_ring.hpp>
 #include <mapbox/geometry/wagyu/interrupt.hpp>
 #include <mapbox/geometry/wagyu/local_minimum.hpp>
+#include <mapbox/geometry/wagyu/memory_resource.hpp>
+#include <mapbox/geometry/wagyu/mvt_encoder.hpp>
 #include <mapbox/geometry/wagyu/snap_rounding.hpp>
 #include <mapbox/geometry/wagyu/topology_correction.hpp>
 #include <mapbox/geometry/wagyu/vatti.hpp>
@@ -29,14 +38,38 @@ namespace wagyu {
 template <typename T>
 class wagyu {
 private:
+    memory_resource* resource;
     local_minimum_list<T> minima_list;
+    ring_manager<T> manager;
+    minima_cluster_list<T> clusters;
+    std::size_t thread_count;
+    std::size_t input_vertices;
+    std::size_t point_hint;
     bool reverse_output;
+    bool render_output;
+    bool hot_pixels_ready;
+    std::uint8_t topology_phases;
 
     wagyu(wagyu const&) = delete;
     wagyu& operator=(wagyu const&) = delete;
 
 public:
-    wagyu() : minima_list(), reverse_output(false) {
+    wagyu() : wagyu(get_default_resource()) {
+    }
+
+    // All memory used by this object is obtained from the resource, which must outlive it
+    explicit wagyu(memory_resource* resource_)
+        : resource(resource_ == nullptr ? new_delete_resource() : resource_),
+          minima_list(resource),
+          manager(resource),
+          clusters(resource),
+          thread_count(1),
+          input_vertices(0),
+          point_hint(0),
+          reverse_output(false),
+          render_output(false),
+          hot_pixels_ready(false),
+          topology_phases(0) {
     }
 
     ~wagyu() {
@@ -45,6 +78,9 @@ public:
 
     template <typename T2>
     bool add_ring(mapbox::geometry::linear_ring<T2> const& pg, polygon_type p_type = polygon_type_subject) {
+        memory_resource_scope scope(resource);
+        hot_pixels_ready = false;
+        input_vertices += pg.size();
         return add_linear_ring(pg, minima_list, p_type);
     }
 
@@ -59,12 +95,108 @@ public:
         return result;
     }
 
+    // Adds a ring of `count` points read in place from `xy`, which holds x, y pairs
+    template <typename T2>
+    bool add_ring(T2 const* xy, std::size_t count, polygon_type p_type = polygon_type_subject) {
+        memory_resource_scope scope(resource);
+        hot_pixels_ready = false;
+        input_vertices += count;
+        return add_linear_ring(interleaved_ring<T2>(xy, count), minima_list, p_type);
+    }
+
+    // Adds `ring_count` rings read in place from `xy`, which holds x, y pairs. Ring i is made
+    // of points [ring_offsets[i], ring_offsets[i + 1]), so there is one more offset than rings,
+    // as in the GeoArrow layout.
+    template <typename T2, typename Offset>
+    bool add_rings(T2 const* xy,
+                   Offset const* ring_offsets,
+                   std::size_t ring_count,
+                   polygon_type p_type = polygon_type_subject) {
+        bool result = false;
+        for (std::size_t i = 0; i < ring_count; ++i) {
+            auto first = static_cast<std::size_t>(ring_offsets[i]);
+            auto last = static_cast<std::size_t>(ring_offsets[i + 1]);
+            if (add_ring(xy + 2 * first, last - first, p_type)) {
+                result = true;
+            }
+        }
+        return result;
+    }
+
+    template <typename T2>
+    bool add_multi_polygon(mapbox::geometry::multi_polygon<T2> const& mp, polygon_type p_type = polygon_type_subject) {
+        std::size_t vertices = 0;
+        for (auto const& poly : mp) {
+            for (auto const& r : poly) {
+                vertices += r.size();
+            }
+        }
+        reserve(input_vertices + vertices);
+        bool result = false;
+        for (auto const& poly : mp) {
+            if (add_polygon(poly, p_type)) {
+                result = true;
+            }
+        }
+        return result;
+    }
+
+    // Sizes the storage for input of about this many vertices in all, counting those already
+    // added, so that the edges are allocated at once rather than in growing chunks. The points
+    // of the result are then allocated for at least as many vertices, with some room for the
+    // intersections, as rings that share vertices give a point for each.
+    void reserve(std::size_t total_vertices) {
+        memory_resource_scope scope(resource);
+        if (total_vertices > input_vertices) {
+            minima_list.edge_storage.reserve(total_vertices - input_vertices);
+        }
+        point_hint = std::max(point_hint, total_vertices);
+    }
+
     void reverse_rings(bool value) {
         reverse_output = value;
     }
 
+    // Output that is only drawn with an even-odd fill can skip most of topology correction,
+    // leaving rings that touch unsplit and holes under an outer ring that may not contain them
+    void set_render_output(bool value) {
+        render_output = value;
+    }
+
+    // Selects how crossing bounds are found during the sweep, the result is the same for all methods
+    void set_crossing_sort(crossing_sort_type method) {
+        manager.crossing_method = method;
+        for (auto& cluster : clusters) {
+            cluster.manager.crossing_method = method;
+        }
+    }
+
+    // Parts of the input whose bounding boxes are apart are clipped concurrently on up to this
+    // many threads, including the calling one. Input that is all in one piece is snap rounded in
+    // horizontal bands and has the points of its rings checked for self intersections on as many
+    // threads instead. The memory resource must then be safe to use from several threads at once.
+    // With the default of 1 everything runs on the calling thread.
+    void set_threads(std::size_t count) {
+        thread_count = count == 0 ? 1 : count;
+        hot_pixels_ready = false;
+    }
+
+    // The topology_phase bits of the phases of topology correction that ran during the last
+    // call to execute. Phases with nothing to do for its result are skipped.
+    std::uint8_t get_topology_phases() const {
+        return topology_phases;
+    }
+
+    memory_resource* get_memory_resource() const {
+        return resource;
+    }
+
     void clear() {
+        clusters.clear();
         minima_list.clear();
+        input_vertices = 0;
+        point_hint = 0;
+        hot_pixels_ready = false;
     }
 
     mapbox::geometry::box<T> get_bounds() {
@@ -116,29 +248,174 @@ public:
                  mapbox::geometry::multi_polygon<T2>& solution,
                  fill_type subject_fill_type,
                  fill_type clip_fill_type) {
+        return execute_into(cliptype, solution, subject_fill_type, clip_fill_type);
+    }
 
+    // Appends the result to flat arrays instead, which can be cleared and reused between calls
+    template <typename T2>
+    bool execute(clip_type cliptype,
+                 flat_multi_polygon<T2>& solution,
+                 fill_type subject_fill_type,
+                 fill_type clip_fill_type) {
+        return execute_into(cliptype, solution, subject_fill_type, clip_fill_type);
+    }
+
+    // Hands the polygons of the result to a visitor as they are read from the rings, see
+    // visit_result. Returns false if there was no input, like the other overloads, whether or
+    // not the visitor stopped early.
+    template <typename Visitor>
+    bool execute(clip_type cliptype, Visitor& visitor, fill_type subject_fill_type, fill_type clip_fill_type) {
+        return execute_into(cliptype, visitor, subject_fill_type, clip_fill_type);
+    }
+
+private:
+    template <typename Solution>
+    bool execute_into(clip_type cliptype, Solution& solution, fill_type subject_fill_type, fill_type clip_fill_type) {
+
+        topology_phases = 0;
         if (minima_list.empty()) {
             return false;
         }
 
-        ring_manager<T> manager;
+        memory_resource_scope scope(resource);
 
-        interrupt_check(); // Check for interruptions
-
-        build_hot_pixels(minima_list, manager);
+        prepare_hot_pixels();
 
         interrupt_check(); // Check for interruptions
 
+        if (!clusters.empty()) {
+            execute_clusters(cliptype, solution, subject_fill_type, clip_fill_type, is_result_container<Solution>());
+            return true;
+        }
+
         execute_vatti(minima_list, manager, cliptype, subject_fill_type, clip_fill_type);
 
         interrupt_check(); // Check for interruptions
 
-        correct_topology(manager);
+        topology_phases = correct_rings(manager, thread_count);
 
-        build_result(solution, manager, reverse_output);
+        emit_result(solution, manager, reverse_output, is_result_container<Solution>());
 
         return true;
     }
+
+    void prepare_hot_pixels() {
+        // The ring manager is kept between calls to execute so that
+        // its memory can be reused, it only needs to be rewound here.
+        // Snap rounding does not depend on the clip or fill types, so
+        // its hot pixels are kept for further calls until the input
+        // changes. Running several operations on the same input only
+        // pays for it once.
+        if (!hot_pixels_ready) {
+            clusters.clear();
+            if (thread_count > 1) {
+                build_minima_clusters(minima_list, clusters, resource);
+            }
+            if (clusters.empty()) {
+                manager.reset();
+
+                interrupt_check(); // Check for interruptions
+
+                std::size_t bands = std::min(thread_count, count_edges() / hot_pixel_band_min_edges);
+                if (bands > 1) {
+                    build_hot_pixels_in_bands(sort_local_minima(minima_list), manager, bands, resource);
+                } else {
+                    build_hot_pixels(minima_list, manager);
+                }
+                if (point_hint > 0) {
+                    std::size_t estimate = std::max(manager.hot_pixels.size(), point_hint);
+                    preallocate_point_memory(manager, estimate + estimate / 4);
+                }
+            } else {
+                run_concurrently(clusters.size(), thread_count, resource, [this](std::size_t i) {
+                    auto& cluster = clusters[i];
+                    cluster.manager.crossing_method = manager.crossing_method;
+                    cluster.manager.reset();
+                    build_hot_pixels(cluster.minima, cluster.manager);
+                });
+            }
+            hot_pixels_ready = true;
+        } else if (clusters.empty()) {
+            manager.reset_rings();
+        }
+    }
+
+    std::uint8_t correct_rings(ring_manager<T>& rings, std::size_t threads) {
+        if (render_output) {
+            return correct_topology_for_rendering(rings, threads);
+        }
+        return correct_topology(rings, threads);
+    }
+
+    std::size_t count_edges() const {
+        std::size_t count = 0;
+        for (auto const& lm : minima_list) {
+            count += lm.left_bound.edges.size() + lm.right_bound.edges.size();
+        }
+        return count;
+    }
+
+    std::uint8_t clip_cluster(minima_cluster<T>& cluster,
+                              clip_type cliptype,
+                              fill_type subject_fill_type,
+                              fill_type clip_fill_type) {
+        cluster.manager.reset_rings();
+        execute_vatti(cluster.minima, cluster.manager, cliptype, subject_fill_type, clip_fill_type);
+
+        interrupt_check(); // Check for interruptions
+
+        return correct_rings(cluster.manager, 1);
+    }
+
+    // Each cluster is clipped with its own ring manager on one of the threads, which then calls
+    // on_clipped with the index of the cluster
+    template <typename OnClipped>
+    void clip_clusters(clip_type cliptype,
+                       fill_type subject_fill_type,
+                       fill_type clip_fill_type,
+                       OnClipped on_clipped) {
+        std::vector<std::uint8_t, resource_allocator<std::uint8_t>> phases(clusters.size(), 0, resource);
+        run_concurrently(clusters.size(), thread_count, resource, [&](std::size_t i) {
+            phases[i] = clip_cluster(clusters[i], cliptype, subject_fill_type, clip_fill_type);
+            on_clipped(i);
+        });
+        for (auto p : phases) {
+            topology_phases |= p;
+        }
+    }
+
+    // Containers are built on the threads that clipped the clusters and appended in the order of
+    // the clusters
+    template <typename Solution>
+    void execute_clusters(clip_type cliptype,
+                          Solution& solution,
+                          fill_type subject_fill_type,
+                          fill_type clip_fill_type,
+                          std::true_type) {
+        std::vector<Solution, resource_allocator<Solution>> results(clusters.size(), resource);
+        clip_clusters(cliptype, subject_fill_type, clip_fill_type, [&](std::size_t i) {
+            build_result(results[i], clusters[i].manager, reverse_output);
+        });
+        for (auto& result : results) {
+            append_result(solution, result);
+        }
+    }
+
+    // Visitors are handed the clusters in order on this thread once they have all been clipped
+    template <typename Visitor>
+    void execute_clusters(clip_type cliptype,
+                          Visitor& visitor,
+                          fill_type subject_fill_type,
+                          fill_type clip_fill_type,
+                          std::false_type) {
+        clip_clusters(cliptype, subject_fill_type, clip_fill_type, [](std::size_t) {});
+        for (auto& cluster : clusters) {
+            cluster.manager.bind_pools();
+            if (!visit_result(visitor, cluster.manager, reverse_output)) {
+                break;
+            }
+        }
+    }
 };
 } // namespace wagyu
 } // namespace geometry
@@ -0,0 +1,86 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <deque>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+void setup_bound(bound<T>& bnd, std::deque<edge<T>>& edges, T x) {
+    edges.emplace_back(mapbox::geometry::point<T>(x, 10), mapbox::geometry::point<T>(x, 0));
+    bnd.edges = edge_span<T>(&edges.back(), &edges.back() + 1);
+    bnd.current_edge = bnd.edges.begin();
+    bnd.next_edge = std::next(bnd.current_edge);
+    bnd.current_x = static_cast<double>(x);
+}
+
+bool positions_match(active_bound_list<T> const& active_bounds) {
+    for (std::size_t i = 0; i < active_bounds.size(); ++i) {
+        if (active_bounds[i]->pos != i) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("bound positions are kept up to date in the active bound list") {
+    std::deque<bound<T>> bounds(8);
+    std::deque<edge<T>> edges;
+    active_bound_list<T> active_bounds;
+    T xs[4] = { 30, 0, 20, 10 };
+    for (std::size_t i = 0; i < 4; ++i) {
+        setup_bound(bounds[2 * i], edges, xs[i]);
+        setup_bound(bounds[2 * i + 1], edges, xs[i] + 5);
+        auto itr = insert_bound_into_ABL(bounds[2 * i], bounds[2 * i + 1], active_bounds);
+        CHECK(*itr == &bounds[2 * i]);
+        CHECK(positions_match(active_bounds));
+    }
+    REQUIRE(active_bounds.size() == 8);
+    for (std::size_t i = 1; i < active_bounds.size(); ++i) {
+        CHECK(active_bounds[i - 1]->current_x < active_bounds[i]->current_x);
+    }
+    for (auto& bnd : bounds) {
+        CHECK(*find_bound(&bnd, active_bounds) == &bnd);
+    }
+
+    swap_bounds<T>(active_bounds.begin(), std::next(active_bounds.begin()), active_bounds);
+    CHECK(positions_match(active_bounds));
+
+    active_bounds[1] = nullptr;
+    active_bounds[4] = nullptr;
+    remove_null_bounds(active_bounds);
+    REQUIRE(active_bounds.size() == 6);
+    CHECK(positions_match(active_bounds));
+
+    // A stale position still finds the bound
+    active_bounds[0]->pos = 5;
+    CHECK(find_bound(active_bounds[0], active_bounds) == active_bounds.begin());
+}
+
+TEST_CASE("updating current x reports bounds that are out of order") {
+    std::deque<bound<T>> bounds(3);
+    std::deque<edge<T>> edges;
+    active_bound_list<T> active_bounds;
+    edges.emplace_back(mapbox::geometry::point<T>(0, 10), mapbox::geometry::point<T>(0, 0));
+    edges.emplace_back(mapbox::geometry::point<T>(20, 10), mapbox::geometry::point<T>(10, 0));
+    edges.emplace_back(mapbox::geometry::point<T>(20, 10), mapbox::geometry::point<T>(30, 0));
+    for (std::size_t i = 0; i < 3; ++i) {
+        bounds[i].edges = edge_span<T>(&edges[i], &edges[i] + 1);
+        bounds[i].current_edge = bounds[i].edges.begin();
+        active_bounds.push_back(&bounds[i]);
+    }
+    CHECK_FALSE(update_current_x(active_bounds, T(5)));
+    CHECK(bounds[1].current_x == Approx(15.0));
+    CHECK(bounds[2].current_x == Approx(25.0));
+    CHECK(positions_match(active_bounds));
+
+    // The last two bounds cross below y = 10
+    std::swap(active_bounds[1], active_bounds[2]);
+    CHECK(update_current_x(active_bounds, T(5)));
+    CHECK(positions_match(active_bounds));
+    CHECK_FALSE(update_current_x(active_bounds, T(10)));
+}
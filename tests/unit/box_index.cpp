@@ -0,0 +1,62 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("box index finds the boxes that contain a box") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<T> pos(0, 1000);
+    std::uniform_int_distribution<T> size(0, 300);
+    std::vector<mapbox::geometry::box<T>> boxes;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        T x = pos(rng);
+        T y = pos(rng);
+        boxes.emplace_back(mapbox::geometry::point<T>(x, y), mapbox::geometry::point<T>(x + size(rng), y + size(rng)));
+    }
+    box_index<T> index;
+    build_box_index(index, boxes);
+    for (std::size_t i = 0; i < boxes.size(); i += 7) {
+        std::vector<std::size_t> expected;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (box2_contains_box1(boxes[i], boxes[j])) {
+                expected.push_back(j);
+            }
+        }
+        std::vector<std::size_t> found;
+        find_boxes_containing(index, boxes[i], i, [&found](std::size_t j) { found.push_back(j); });
+        std::sort(found.begin(), found.end());
+        CHECK(found == expected);
+    }
+}
+
+TEST_CASE("many holes are placed in the right shells") {
+    mapbox::geometry::polygon<T> shell = { { { 0, 0 }, { 1000, 0 }, { 1000, 1000 }, { 0, 1000 }, { 0, 0 } } };
+    mapbox::geometry::polygon<T> other = { { { 2000, 0 }, { 3000, 0 }, { 3000, 1000 }, { 2000, 1000 }, { 2000, 0 } } };
+    wagyu<T> clipper;
+    clipper.add_polygon(shell, polygon_type_subject);
+    clipper.add_polygon(other, polygon_type_subject);
+    for (T i = 0; i < 10; ++i) {
+        for (T j = 0; j < 10; ++j) {
+            for (T x : { T(0), T(2000) }) {
+                mapbox::geometry::polygon<T> hole = { { { x + 10 + i * 100, 10 + j * 100 },
+                                                        { x + 10 + i * 100, 60 + j * 100 },
+                                                        { x + 60 + i * 100, 60 + j * 100 },
+                                                        { x + 60 + i * 100, 10 + j * 100 },
+                                                        { x + 10 + i * 100, 10 + j * 100 } } };
+                clipper.add_polygon(hole, polygon_type_clip);
+            }
+        }
+    }
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_difference, solution, fill_type_even_odd, fill_type_even_odd);
+    REQUIRE(solution.size() == 2);
+    CHECK(solution[0].size() == 101);
+    CHECK(solution[1].size() == 101);
+}
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include "../util/random_input.hpp"
+
+#include <cstddef>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+// Squares with a square hole, far enough apart to be clustered
+void add_squares(wagyu<T>& clipper) {
+    for (T i = 0; i < 5; ++i) {
+        T x = i * 100;
+        mapbox::geometry::polygon<T> square = { { { x, 0 }, { x + 10, 0 }, { x + 10, 10 }, { x, 10 }, { x, 0 } },
+                                                { { x + 2, 2 }, { x + 2, 4 }, { x + 4, 4 }, { x + 4, 2 }, { x + 2, 2 } } };
+        clipper.add_polygon(square, polygon_type_subject);
+    }
+}
+
+void check_same(mapbox::geometry::multi_polygon<T> const& expected, flat_multi_polygon<T> const& flat) {
+    REQUIRE(flat.polygon_count() == expected.size());
+    REQUIRE(flat.ring_offsets.back() == flat.points.size());
+    for (std::size_t p = 0; p < expected.size(); ++p) {
+        REQUIRE(flat.polygon_offsets[p + 1] - flat.polygon_offsets[p] == expected[p].size());
+        for (std::size_t r = 0; r < expected[p].size(); ++r) {
+            std::size_t ring = flat.polygon_offsets[p] + r;
+            std::size_t first = flat.ring_offsets[ring];
+            std::size_t last = flat.ring_offsets[ring + 1];
+            mapbox::geometry::linear_ring<T> lr(flat.points.begin() + static_cast<std::ptrdiff_t>(first),
+                                                flat.points.begin() + static_cast<std::ptrdiff_t>(last));
+            CHECK(lr == expected[p][r]);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("flat results hold the same rings as a multi polygon") {
+    for (std::size_t threads : { 1, 3 }) {
+        wagyu<T> clipper;
+        clipper.set_threads(threads);
+        add_squares(clipper);
+        mapbox::geometry::multi_polygon<T> expected;
+        flat_multi_polygon<T> flat;
+        clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+        clipper.execute(clip_type_union, flat, fill_type_even_odd, fill_type_even_odd);
+        CHECK(expected.size() == 5);
+        check_same(expected, flat);
+
+        // Clearing keeps the capacity for the next call
+        std::size_t capacity = flat.points.capacity();
+        flat.clear();
+        CHECK(flat.empty());
+        clipper.execute(clip_type_union, flat, fill_type_even_odd, fill_type_even_odd);
+        CHECK(flat.points.capacity() == capacity);
+        check_same(expected, flat);
+    }
+}
+
+TEST_CASE("flat results of random inputs hold the same rings as a multi polygon") {
+    std::mt19937 rng(2017);
+    for (std::size_t k = 0; k < 200; ++k) {
+        wagyu<T> clipper;
+        add_random_input(clipper, rng);
+        mapbox::geometry::multi_polygon<T> expected;
+        flat_multi_polygon<T> flat;
+        clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+        clipper.execute(clip_type_union, flat, fill_type_even_odd, fill_type_even_odd);
+        check_same(expected, flat);
+    }
+}
+
+namespace {
+
+struct collecting_visitor {
+    mapbox::geometry::multi_polygon<T> polygons;
+    std::size_t max_polygons;
+
+    explicit collecting_visitor(std::size_t max_polygons_) : polygons(), max_polygons(max_polygons_) {
+    }
+
+    void begin_polygon() {
+        polygons.emplace_back();
+    }
+
+    void ring(ring_point_iterator<T> begin, ring_point_iterator<T> end) {
+        polygons.back().emplace_back(begin, end);
+    }
+
+    bool end_polygon() {
+        return polygons.size() < max_polygons;
+    }
+};
+} // namespace
+
+TEST_CASE("a visitor is handed the same polygons as a multi polygon and can stop early") {
+    for (std::size_t threads : { 1, 3 }) {
+        wagyu<T> clipper;
+        clipper.set_threads(threads);
+        add_squares(clipper);
+        mapbox::geometry::multi_polygon<T> expected;
+        clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+
+        collecting_visitor all(expected.size() + 1);
+        clipper.execute(clip_type_union, all, fill_type_even_odd, fill_type_even_odd);
+        CHECK(all.polygons == expected);
+
+        collecting_visitor first_two(2);
+        clipper.execute(clip_type_union, first_two, fill_type_even_odd, fill_type_even_odd);
+        REQUIRE(first_two.polygons.size() == 2);
+        CHECK(first_two.polygons[0] == expected[0]);
+        CHECK(first_two.polygons[1] == expected[1]);
+    }
+}
+
+TEST_CASE("a visitor is handed the same polygons as a multi polygon for random inputs") {
+    std::mt19937 rng(2017);
+    for (std::size_t k = 0; k < 200; ++k) {
+        wagyu<T> clipper;
+        add_random_input(clipper, rng);
+        for (bool reverse : { false, true }) {
+            clipper.reverse_rings(reverse);
+            mapbox::geometry::multi_polygon<T> expected;
+            clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+            collecting_visitor all(expected.size() + 1);
+            clipper.execute(clip_type_union, all, fill_type_even_odd, fill_type_even_odd);
+            CHECK(all.polygons == expected);
+        }
+    }
+}
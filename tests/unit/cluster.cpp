@@ -0,0 +1,115 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+mapbox::geometry::polygon<T> square(T x, T y, T size) {
+    return { { { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size }, { x, y } } };
+}
+
+// The polygons of a solution flattened and sorted, so that solutions can be compared
+// regardless of the order their polygons are in
+std::vector<std::vector<T>> flatten(mapbox::geometry::multi_polygon<T> const& solution) {
+    std::vector<std::vector<T>> result;
+    for (auto const& poly : solution) {
+        std::vector<T> values;
+        for (auto const& ring : poly) {
+            values.push_back(static_cast<T>(ring.size()));
+            for (auto const& pt : ring) {
+                values.push_back(pt.x);
+                values.push_back(pt.y);
+            }
+        }
+        result.push_back(values);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+} // namespace
+
+TEST_CASE("local minima are grouped by touching bounding boxes") {
+    local_minimum_list<T> minima_list;
+    for (auto const& ring : square(0, 0, 10)) {
+        add_linear_ring(ring, minima_list, polygon_type_subject);
+    }
+    for (auto const& ring : square(100, 0, 10)) {
+        add_linear_ring(ring, minima_list, polygon_type_subject);
+    }
+    // Shares an edge with the first square
+    for (auto const& ring : square(10, 5, 10)) {
+        add_linear_ring(ring, minima_list, polygon_type_clip);
+    }
+    REQUIRE(minima_list.size() == 3);
+
+    minima_cluster_list<T> clusters;
+    build_minima_clusters(minima_list, clusters, get_default_resource());
+    REQUIRE(clusters.size() == 2);
+    REQUIRE(clusters[0].minima.size() == 2);
+    CHECK(clusters[0].minima[0] == &minima_list[2]);
+    CHECK(clusters[0].minima[1] == &minima_list[0]);
+    REQUIRE(clusters[1].minima.size() == 1);
+    CHECK(clusters[1].minima[0] == &minima_list[1]);
+
+    // Everything connected gives no clusters at all
+    minima_cluster_list<T> single;
+    local_minimum_list<T> connected;
+    for (auto const& ring : square(0, 0, 10)) {
+        add_linear_ring(ring, connected, polygon_type_subject);
+    }
+    for (auto const& ring : square(5, 5, 10)) {
+        add_linear_ring(ring, connected, polygon_type_clip);
+    }
+    build_minima_clusters(connected, single, get_default_resource());
+    CHECK(single.empty());
+}
+
+TEST_CASE("clipping clusters on several threads gives the same polygons") {
+    for (auto ct : { clip_type_union, clip_type_intersection, clip_type_difference, clip_type_x_or }) {
+        wagyu<T> serial;
+        wagyu<T> threaded;
+        threaded.set_threads(4);
+        for (T i = 0; i < 8; ++i) {
+            for (T j = 0; j < 8; ++j) {
+                auto subject = square(i * 100, j * 100, 30 + i);
+                auto clip = square(i * 100 + 20, j * 100 + 10, 30 + j);
+                serial.add_polygon(subject, polygon_type_subject);
+                serial.add_polygon(clip, polygon_type_clip);
+                threaded.add_polygon(subject, polygon_type_subject);
+                threaded.add_polygon(clip, polygon_type_clip);
+            }
+        }
+        mapbox::geometry::multi_polygon<T> expected;
+        mapbox::geometry::multi_polygon<T> solution;
+        serial.execute(ct, expected, fill_type_even_odd, fill_type_even_odd);
+        threaded.execute(ct, solution, fill_type_even_odd, fill_type_even_odd);
+        CHECK(flatten(solution) == flatten(expected));
+
+        // The clusters are kept for the next execution
+        mapbox::geometry::multi_polygon<T> again;
+        threaded.execute(ct, again, fill_type_even_odd, fill_type_even_odd);
+        CHECK(again == solution);
+    }
+}
+
+TEST_CASE("running concurrently rethrows the first exception") {
+    std::vector<int> done(100, 0);
+    run_concurrently(done.size(), 4, get_default_resource(), [&done](std::size_t i) { done[i] = 1; });
+    CHECK(std::count(done.begin(), done.end(), 1) == 100);
+
+    CHECK_THROWS_WITH(run_concurrently(10, 1, get_default_resource(),
+                                       [](std::size_t i) {
+                                           if (i >= 3) {
+                                               throw std::runtime_error(std::to_string(i));
+                                           }
+                                       }),
+                      "3");
+}
@@ -0,0 +1,70 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/crossing_sort.hpp>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+
+namespace {
+
+struct item {
+    double key;
+    int id;
+};
+
+using swap_list = std::vector<std::pair<int, int>>;
+
+swap_list sort_items(std::vector<item>& items, crossing_sort_type method) {
+    swap_list swaps;
+    crossing_sort(items.begin(), items.end(), [](item const& i) { return i.key; },
+                  [](item const& a, item const& b) { return a.key <= b.key; },
+                  [&swaps](item const& a, item const& b) { swaps.emplace_back(a.id, b.id); }, method);
+    return swaps;
+}
+} // namespace
+
+TEST_CASE("crossing sort reports the same swaps as bubble sort") {
+    std::mt19937 rng(1234);
+    for (std::size_t n : { 2, 3, 10, 50, 200 }) {
+        for (int keys : { 4, 1000 }) {
+            std::uniform_int_distribution<int> dist(0, keys);
+            for (int trial = 0; trial < 20; ++trial) {
+                std::vector<item> items;
+                for (std::size_t i = 0; i < n; ++i) {
+                    items.push_back({ static_cast<double>(dist(rng)), static_cast<int>(i) });
+                }
+                std::vector<item> bubble = items;
+                swap_list expected = sort_items(bubble, crossing_sort_bubble);
+                for (auto method : { crossing_sort_merge, crossing_sort_adaptive }) {
+                    std::vector<item> sorted = items;
+                    CHECK(sort_items(sorted, method) == expected);
+                    bool same_order = true;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        same_order = same_order && sorted[i].id == bubble[i].id;
+                    }
+                    CHECK(same_order);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("crossing sort falls back to bubble sort when the comparator keeps an inverted pair") {
+    // Items with the same id parity are never swapped, like parallel bounds in the active bound list
+    std::vector<item> items = { { 3.0, 0 }, { 2.0, 1 }, { 1.0, 2 }, { 0.0, 3 }, { 4.0, 4 } };
+    auto compare = [](item const& a, item const& b) { return !(a.key > b.key && (a.id % 2) != (b.id % 2)); };
+    std::vector<item> bubble = items;
+    swap_list expected;
+    bubble_sort(bubble.begin(), bubble.end(), compare,
+                [&expected](item const& a, item const& b) { expected.emplace_back(a.id, b.id); });
+    swap_list swaps;
+    crossing_sort(items.begin(), items.end(), [](item const& i) { return i.key; }, compare,
+                  [&swaps](item const& a, item const& b) { swaps.emplace_back(a.id, b.id); }, crossing_sort_merge);
+    CHECK(swaps == expected);
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        CHECK(items[i].id == bubble[i].id);
+    }
+}
@@ -0,0 +1,86 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("edges built from interleaved coordinates match those of a linear ring") {
+    // Repeated, collinear and closing points exercise every branch of build_edge_list
+    std::vector<std::int32_t> xy = { 0, 0, 0, 0, 5, 0, 10, 0, 10, 10, 5, 12, 0, 10, 0, 5, 0, 0 };
+    mapbox::geometry::linear_ring<std::int32_t> ring;
+    for (std::size_t i = 0; i < xy.size(); i += 2) {
+        ring.push_back({ xy[i], xy[i + 1] });
+    }
+    edge_list<T> expected;
+    edge_list<T> edges;
+    REQUIRE(build_edge_list(ring, expected));
+    REQUIRE(build_edge_list(interleaved_ring<std::int32_t>(xy.data(), xy.size() / 2), edges));
+    REQUIRE(edges.size() == expected.size());
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        CHECK(edges[i].bot == expected[i].bot);
+        CHECK(edges[i].top == expected[i].top);
+    }
+}
+
+TEST_CASE("rings added from flat buffers give the same result as polygons") {
+    // A square with a hole, and a triangle overlapping it as the clip
+    std::vector<std::int32_t> subject_xy = { 0, 0, 10, 0, 10, 10, 0, 10, 0, 0, 2, 2, 2, 4, 4, 4, 4, 2, 2, 2 };
+    std::vector<std::uint32_t> offsets = { 0, 5, 10 };
+    std::vector<std::int32_t> clip_xy = { 5, -5, 15, 5, 5, 15 };
+    mapbox::geometry::polygon<std::int32_t> subject = { { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } },
+                                                        { { 2, 2 }, { 2, 4 }, { 4, 4 }, { 4, 2 }, { 2, 2 } } };
+    mapbox::geometry::polygon<std::int32_t> clip = { { { 5, -5 }, { 15, 5 }, { 5, 15 } } };
+
+    wagyu<T> from_polygons;
+    from_polygons.add_polygon(subject, polygon_type_subject);
+    from_polygons.add_polygon(clip, polygon_type_clip);
+    wagyu<T> from_buffers;
+    CHECK(from_buffers.add_rings(subject_xy.data(), offsets.data(), 2, polygon_type_subject));
+    CHECK(from_buffers.add_ring(clip_xy.data(), 3, polygon_type_clip));
+    CHECK_FALSE(from_buffers.add_ring(clip_xy.data(), 2, polygon_type_clip));
+
+    for (auto ct : { clip_type_union, clip_type_intersection, clip_type_difference }) {
+        mapbox::geometry::multi_polygon<T> expected;
+        mapbox::geometry::multi_polygon<T> solution;
+        from_polygons.execute(ct, expected, fill_type_even_odd, fill_type_even_odd);
+        from_buffers.execute(ct, solution, fill_type_even_odd, fill_type_even_odd);
+        CHECK(solution == expected);
+    }
+}
+
+TEST_CASE("a multi polygon added at once gives the same result as its polygons") {
+    // Squares with gaps between them, so that every square the clip covers stays a polygon
+    mapbox::geometry::multi_polygon<T> mosaic;
+    for (T i = 0; i < 6; ++i) {
+        for (T j = 0; j < 6; ++j) {
+            mosaic.push_back({ { { i * 10, j * 10 },
+                                 { i * 10 + 8, j * 10 },
+                                 { i * 10 + 8, j * 10 + 8 },
+                                 { i * 10, j * 10 + 8 },
+                                 { i * 10, j * 10 } } });
+        }
+    }
+    mapbox::geometry::polygon<T> clip = { { { 5, 5 }, { 45, 5 }, { 45, 45 }, { 5, 45 }, { 5, 5 } } };
+
+    wagyu<T> by_polygon;
+    for (auto const& poly : mosaic) {
+        by_polygon.add_polygon(poly, polygon_type_subject);
+    }
+    by_polygon.add_polygon(clip, polygon_type_clip);
+    wagyu<T> at_once;
+    at_once.reserve(mosaic.size() * 5 + 5);
+    CHECK(at_once.add_multi_polygon(mosaic, polygon_type_subject));
+    CHECK(at_once.add_polygon(clip, polygon_type_clip));
+
+    mapbox::geometry::multi_polygon<T> expected;
+    mapbox::geometry::multi_polygon<T> solution;
+    by_polygon.execute(clip_type_intersection, expected, fill_type_non_zero, fill_type_non_zero);
+    at_once.execute(clip_type_intersection, solution, fill_type_non_zero, fill_type_non_zero);
+    CHECK(expected.size() == 25);
+    CHECK(solution == expected);
+}
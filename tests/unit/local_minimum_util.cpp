@@ -683,3 +683,44 @@ TEST_CASE("edge adding insane set of lines") {
     ++itr;
     CHECK(itr == edges2_r.end());
 }
+
+TEST_CASE("bounds of added rings share the edge pool") {
+    local_minimum_list<T> minima_list;
+    for (T i = 0; i < 100; ++i) {
+        mapbox::geometry::linear_ring<T> ring;
+        ring.push_back({ 30 * i, 0 });
+        ring.push_back({ 30 * i + 10, 10 });
+        ring.push_back({ 30 * i + 20, 0 });
+        ring.push_back({ 30 * i + 20, 20 });
+        ring.push_back({ 30 * i, 20 });
+        ring.push_back({ 30 * i, 0 });
+        CHECK(add_linear_ring(ring, minima_list, polygon_type_subject));
+    }
+    REQUIRE(minima_list.size() == 200);
+    std::size_t edge_count = 0;
+    for (auto const& chunk : minima_list.edge_storage.chunks) {
+        edge_count += chunk.size();
+    }
+    CHECK(edge_count == 500);
+    CHECK(minima_list.edge_storage.chunks.size() < 4);
+    for (auto const& lm : minima_list) {
+        CHECK_FALSE(lm.left_bound.edges.empty());
+        CHECK_FALSE(lm.right_bound.edges.empty());
+    }
+    minima_list.clear();
+    CHECK(minima_list.edge_storage.chunks.empty());
+}
+
+TEST_CASE("edges of rings fit in a reserved chunk of the edge pool") {
+    local_minimum_list<T> minima_list;
+    minima_list.edge_storage.reserve(1000);
+    REQUIRE(minima_list.edge_storage.chunks.size() == 1);
+    for (T i = 0; i < 100; ++i) {
+        mapbox::geometry::linear_ring<T> ring = {
+            { 30 * i, 0 }, { 30 * i + 10, 10 }, { 30 * i + 20, 0 }, { 30 * i + 20, 20 }, { 30 * i, 20 }, { 30 * i, 0 }
+        };
+        CHECK(add_linear_ring(ring, minima_list, polygon_type_subject));
+    }
+    CHECK(minima_list.edge_storage.chunks.size() == 1);
+    CHECK(minima_list.edge_storage.chunks.front().size() == 500);
+}
@@ -0,0 +1,95 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/polygon.hpp>
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+class counting_resource : public memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t) override {
+        ++allocations;
+        outstanding += bytes;
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t) override {
+        outstanding -= bytes;
+        ::operator delete(p);
+    }
+};
+
+mapbox::geometry::polygon<T> make_test_polygon(T offset) {
+    mapbox::geometry::polygon<T> polygon;
+    polygon.push_back({ { offset, offset },
+                        { offset + 100, offset },
+                        { offset + 100, offset + 100 },
+                        { offset, offset + 100 },
+                        { offset, offset } });
+    polygon.push_back({ { offset + 20, offset + 20 },
+                        { offset + 20, offset + 80 },
+                        { offset + 80, offset + 80 },
+                        { offset + 80, offset + 20 },
+                        { offset + 20, offset + 20 } });
+    return polygon;
+}
+} // namespace
+
+TEST_CASE("wagyu allocates through its memory resource") {
+    counting_resource resource;
+    mapbox::geometry::multi_polygon<T> expected;
+    {
+        wagyu<T> plain;
+        plain.add_polygon(make_test_polygon(0), polygon_type_subject);
+        plain.add_polygon(make_test_polygon(50), polygon_type_clip);
+        plain.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+    }
+    {
+        wagyu<T> w(&resource);
+        CHECK(w.get_memory_resource() == &resource);
+        w.add_polygon(make_test_polygon(0), polygon_type_subject);
+        w.add_polygon(make_test_polygon(50), polygon_type_clip);
+        CHECK(resource.allocations > 0);
+        mapbox::geometry::multi_polygon<T> solution;
+        w.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+        CHECK(solution == expected);
+        // The calling thread's default resource is restored after each call
+        CHECK(get_default_resource() == new_delete_resource());
+    }
+    CHECK(resource.outstanding == 0);
+}
+
+TEST_CASE("monotonic buffer resource can bound the memory of a job") {
+    monotonic_buffer_resource arena(1024);
+    {
+        wagyu<T> w(&arena);
+        w.add_polygon(make_test_polygon(0), polygon_type_subject);
+        w.add_polygon(make_test_polygon(50), polygon_type_clip);
+        mapbox::geometry::multi_polygon<T> solution;
+        CHECK(w.execute(clip_type_intersection, solution, fill_type_even_odd, fill_type_even_odd));
+        CHECK(solution.size() == 2);
+    }
+    CHECK(arena.bytes_used() > 0);
+    arena.release();
+    CHECK(arena.bytes_used() == 0);
+
+    mapbox::geometry::linear_ring<T> zigzag;
+    for (T i = 0; i < 1000; ++i) {
+        zigzag.push_back({ i, (i % 2) * 10 });
+    }
+    zigzag.push_back({ 999, 100 });
+    zigzag.push_back({ 0, 100 });
+    zigzag.push_back({ 0, 0 });
+
+    monotonic_buffer_resource limited(1024, 16384);
+    wagyu<T> w(&limited);
+    CHECK_THROWS_AS(w.add_ring(zigzag, polygon_type_subject), std::bad_alloc);
+}
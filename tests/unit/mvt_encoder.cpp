@@ -0,0 +1,131 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include "../util/random_input.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+std::int64_t unzigzag(std::uint32_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Decodes the rings of a polygon feature, checking the commands on the way
+std::vector<mapbox::geometry::linear_ring<T>> decode(std::vector<std::uint32_t> const& commands) {
+    std::vector<mapbox::geometry::linear_ring<T>> rings;
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+    std::size_t i = 0;
+    auto read_point = [&]() {
+        x += unzigzag(commands[i++]);
+        y += unzigzag(commands[i++]);
+        rings.back().push_back({ x, y });
+    };
+    while (i < commands.size()) {
+        REQUIRE(commands[i++] == mvt_command(mvt_command_move_to, 1));
+        rings.emplace_back();
+        read_point();
+        REQUIRE((commands[i] & 7) == mvt_command_line_to);
+        std::size_t count = commands[i++] >> 3;
+        for (std::size_t k = 0; k < count; ++k) {
+            read_point();
+        }
+        REQUIRE(commands[i++] == mvt_command(mvt_command_close_path, 1));
+    }
+    return rings;
+}
+
+// Twice the area as the MVT specification works it out
+std::int64_t surveyor_area(mapbox::geometry::linear_ring<T> const& ring) {
+    std::int64_t area = 0;
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        auto const& p1 = ring[i];
+        auto const& p2 = ring[(i + 1) % ring.size()];
+        area += p1.x * p2.y - p2.x * p1.y;
+    }
+    return area;
+}
+} // namespace
+
+TEST_CASE("polygons are encoded as vector tile commands with outer rings of positive area") {
+    mapbox::geometry::polygon<T> square = { { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } },
+                                            { { 2, 2 }, { 2, 4 }, { 4, 4 }, { 4, 2 }, { 2, 2 } } };
+    mapbox::geometry::polygon<T> other = { { { 20, 20 }, { 30, 20 }, { 25, 30 }, { 20, 20 } } };
+    for (bool reverse : { false, true }) {
+        wagyu<T> clipper;
+        clipper.reverse_rings(reverse);
+        clipper.add_polygon(square, polygon_type_subject);
+        clipper.add_polygon(other, polygon_type_subject);
+        mapbox::geometry::multi_polygon<T> expected;
+        clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+
+        std::vector<std::uint32_t> commands;
+        mvt_geometry_encoder<T> encoder(commands);
+        clipper.execute(clip_type_union, encoder, fill_type_even_odd, fill_type_even_odd);
+        auto rings = decode(commands);
+
+        std::size_t r = 0;
+        for (auto const& poly : expected) {
+            for (std::size_t k = 0; k < poly.size(); ++k) {
+                REQUIRE(r < rings.size());
+                CHECK(rings[r].size() + 1 == poly[k].size());
+                if (k == 0) {
+                    CHECK(surveyor_area(rings[r]) > 0);
+                } else {
+                    CHECK(surveyor_area(rings[r]) < 0);
+                }
+                ++r;
+            }
+        }
+        CHECK(r == rings.size());
+        CHECK(r == 3);
+    }
+}
+
+TEST_CASE("decoded commands for random inputs give the rings of a multi polygon") {
+    std::mt19937 rng(2017);
+    for (std::size_t k = 0; k < 200; ++k) {
+        wagyu<T> clipper;
+        add_random_input(clipper, rng);
+        mapbox::geometry::multi_polygon<T> expected;
+        clipper.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+        std::vector<mapbox::geometry::linear_ring<T>> expected_rings;
+        for (auto const& poly : expected) {
+            for (auto const& ring : poly) {
+                expected_rings.push_back(ring);
+                expected_rings.back().pop_back();
+            }
+        }
+
+        // The rings are wound the same way when the output is reversed
+        for (bool reverse : { false, true }) {
+            clipper.reverse_rings(reverse);
+            std::vector<std::uint32_t> commands;
+            mvt_geometry_encoder<T> encoder(commands);
+            clipper.execute(clip_type_union, encoder, fill_type_even_odd, fill_type_even_odd);
+            CHECK(decode(commands) == expected_rings);
+        }
+    }
+}
+
+TEST_CASE("points that do not fit in a vector tile command are not encoded") {
+    T far = static_cast<T>(std::numeric_limits<std::int32_t>::max()) + 10;
+    mapbox::geometry::polygon<T> square = {
+        { { far - 10, 0 }, { far, 0 }, { far, 10 }, { far - 10, 10 }, { far - 10, 0 } }
+    };
+    wagyu<T> clipper;
+    clipper.add_polygon(square, polygon_type_subject);
+    std::vector<std::uint32_t> commands;
+    mvt_geometry_encoder<T> encoder(commands);
+    CHECK_THROWS_AS(clipper.execute(clip_type_union, encoder, fill_type_even_odd, fill_type_even_odd),
+                    std::runtime_error);
+}
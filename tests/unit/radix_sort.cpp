@@ -0,0 +1,77 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("radix sort keeps the order of equal keys") {
+    using keyed = std::pair<std::uint64_t, std::size_t>;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::uint64_t> key(0, 5000);
+    for (std::size_t n : { 5000, 600000 }) {
+        std::vector<keyed> expected;
+        for (std::size_t i = 0; i < n; ++i) {
+            // Spread the few values over the high bits so that the low digits are all the same
+            expected.emplace_back(key(gen) << 30, i);
+        }
+        auto values = expected;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](keyed const& k1, keyed const& k2) { return k1.first < k2.first; });
+        for (std::size_t threads : { 1, 3 }) {
+            auto sorted = values;
+            radix_sort(sorted, [](keyed const& k) { return k.first; }, 43, threads);
+            CHECK(sorted == expected);
+        }
+    }
+}
+
+TEST_CASE("sorting hot pixels with a radix sort matches a comparison sort") {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<T> coord(-500, 500);
+    std::uniform_int_distribution<T> full(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    // Small ranges fit in one key, full ranges take a sort for each coordinate
+    for (bool full_range : { false, true }) {
+        ring_manager<T> manager;
+        for (std::size_t i = 0; i < 20000; ++i) {
+            T x = full_range && i % 2 == 0 ? full(gen) : coord(gen);
+            T y = full_range && i % 3 == 0 ? full(gen) : coord(gen);
+            manager.hot_pixels.emplace_back(x, y);
+        }
+        auto expected = manager.hot_pixels;
+        std::sort(expected.begin(), expected.end(), hot_pixel_sorter<T>());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        sort_hot_pixels(manager);
+        CHECK(manager.hot_pixels == expected);
+    }
+}
+
+TEST_CASE("sorting all points with a radix sort matches point_ptr_cmp") {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<T> coord(-20, 20);
+    ring_manager<T> manager;
+    // Nested rings with repeated points, so that ties are broken on depth and then by order
+    ring_ptr<T> parent = nullptr;
+    for (std::size_t r = 0; r < 40; ++r) {
+        ring_ptr<T> ring = create_new_ring(manager);
+        ring->parent = r % 4 == 0 ? nullptr : parent;
+        parent = ring;
+        ring->points = create_new_point(ring, mapbox::geometry::point<T>(coord(gen), coord(gen)), manager);
+        for (std::size_t i = 0; i < 100; ++i) {
+            create_new_point(ring, mapbox::geometry::point<T>(coord(gen), coord(gen)), ring->points, manager);
+        }
+    }
+    auto expected = manager.all_points;
+    std::stable_sort(expected.begin(), expected.end(), point_ptr_cmp<T>());
+    sort_all_points(manager, 1, std::is_integral<T>());
+    CHECK(manager.all_points == expected);
+}
@@ -0,0 +1,46 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <cstddef>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("point in polygon with the ring edge index matches walking the ring") {
+    ring_manager<T> manager;
+    ring_ptr<T> r = create_new_ring(manager);
+    // A comb with teeth of different lengths, so that rows cross many edges
+    r->points = create_new_point(r, mapbox::geometry::point<T>(0, -50), manager);
+    auto add = [&](T x, T y) { create_new_point(r, mapbox::geometry::point<T>(x, y), r->points, manager); };
+    for (T i = 0; i < 100; ++i) {
+        add(i * 10, 0);
+        add(i * 10, 100 + (i * 37) % 200);
+        add(i * 10 + 5, 100 + (i * 37) % 200);
+        add(i * 10 + 5, 0);
+    }
+    add(1000, 0);
+    add(1000, -50);
+    REQUIRE(r->size() >= ring_edge_index_min_points);
+
+    std::size_t inside = 0;
+    std::size_t on = 0;
+    for (T y = -60; y <= 310; y += 7) {
+        for (T x = -3; x <= 1003; x += 3) {
+            point<T> pt(x, y);
+            auto expected = point_in_polygon(pt, r->points);
+            CHECK(point_in_polygon(pt, r) == expected);
+            mapbox::geometry::point<double> dpt(static_cast<double>(x) + 0.5, static_cast<double>(y));
+            CHECK(point_in_polygon(dpt, r) == point_in_polygon(dpt, r->points));
+            inside += expected == point_inside_polygon ? 1 : 0;
+            on += expected == point_on_polygon ? 1 : 0;
+        }
+    }
+    CHECK(r->edge_index.built());
+    CHECK(inside > 0);
+    CHECK(on > 0);
+
+    // Changing the ring drops the index
+    r->recalculate_stats();
+    CHECK_FALSE(r->edge_index.built());
+}
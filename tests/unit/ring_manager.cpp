@@ -0,0 +1,112 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/polygon.hpp>
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("ring manager reset keeps memory and recycles rings") {
+    ring_manager<T> manager;
+    preallocate_point_memory(manager, 4);
+
+    ring_ptr<T> r1 = create_new_ring(manager);
+    r1->points = create_new_point(r1, mapbox::geometry::point<T>(0, 0), manager);
+    for (T i = 1; i < 8; ++i) {
+        create_new_point(r1, mapbox::geometry::point<T>(i, i), r1->points, manager);
+    }
+    ring_ptr<T> r2 = create_new_ring(manager);
+    r2->parent = r1;
+    r1->children.push_back(r2);
+
+    CHECK(manager.index == 2);
+#ifdef USE_WAGYU_COMPACT_LINKS
+    // Compact links require every point to be in storage
+    CHECK(manager.storage.size() == 8);
+    CHECK(manager.points.size() == 0);
+#else
+    CHECK(manager.storage.size() == 4);
+    CHECK(manager.points.size() == 4);
+#endif
+    CHECK(manager.all_points.size() == 8);
+
+    manager.reset();
+
+    CHECK(manager.index == 0);
+    CHECK(manager.children.empty());
+    CHECK(manager.all_points.empty());
+    CHECK(manager.points.empty());
+    CHECK(manager.storage.empty());
+    // Points that overflowed into the deque now fit in storage
+    CHECK(manager.storage.capacity() >= 8);
+    CHECK(manager.all_points.capacity() >= 8);
+    CHECK(manager.rings.size() == 2);
+
+    ring_ptr<T> r3 = create_new_ring(manager);
+    CHECK(r3 == r1);
+    CHECK(r3->ring_index == 0);
+    CHECK(r3->points == nullptr);
+    CHECK(r3->parent == nullptr);
+    CHECK(r3->children.empty());
+    CHECK(std::isnan(r3->area_));
+
+    ring_ptr<T> r4 = create_new_ring(manager);
+    CHECK(r4 == r2);
+    CHECK(r4->ring_index == 1);
+    CHECK(r4->parent == nullptr);
+
+    ring_ptr<T> r5 = create_new_ring(manager);
+    CHECK(r5->ring_index == 2);
+    CHECK(manager.rings.size() == 3);
+}
+
+TEST_CASE("repeated execute on the same wagyu gives the same result") {
+    mapbox::geometry::polygon<T> polygon1;
+    polygon1.push_back({ { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 } });
+    polygon1.push_back({ { 20, 20 }, { 20, 80 }, { 80, 80 }, { 80, 20 }, { 20, 20 } });
+    mapbox::geometry::polygon<T> polygon2;
+    polygon2.push_back({ { 50, -10 }, { 150, -10 }, { 150, 90 }, { 50, 90 }, { 50, -10 } });
+
+    wagyu<T> w;
+    w.add_polygon(polygon1, polygon_type_subject);
+    w.add_polygon(polygon2, polygon_type_clip);
+
+    for (auto ct : { clip_type_union, clip_type_intersection, clip_type_difference, clip_type_x_or }) {
+        mapbox::geometry::multi_polygon<T> first;
+        mapbox::geometry::multi_polygon<T> second;
+        REQUIRE(w.execute(ct, first, fill_type_even_odd, fill_type_even_odd));
+        REQUIRE(w.execute(ct, second, fill_type_even_odd, fill_type_even_odd));
+
+        wagyu<T> fresh;
+        fresh.add_polygon(polygon1, polygon_type_subject);
+        fresh.add_polygon(polygon2, polygon_type_clip);
+        mapbox::geometry::multi_polygon<T> expected;
+        REQUIRE(fresh.execute(ct, expected, fill_type_even_odd, fill_type_even_odd));
+
+        CHECK(first == expected);
+        CHECK(second == expected);
+    }
+}
+
+#ifdef USE_WAGYU_COMPACT_LINKS
+TEST_CASE("compact links resolve through the ring manager pools") {
+    CHECK(sizeof(point<std::int32_t>) == 20);
+    CHECK(sizeof(point<std::int64_t>) == 32);
+
+    ring_manager<T> manager;
+    ring_ptr<T> r = create_new_ring(manager);
+    r->points = create_new_point(r, mapbox::geometry::point<T>(0, 0), manager);
+    point_ptr<T> first = r->points;
+    // Force the point storage to grow several times
+    for (T i = 1; i < 1000; ++i) {
+        create_new_point(r, mapbox::geometry::point<T>(i, i), r->points, manager);
+    }
+    CHECK(first == r->points);
+    CHECK(r->points->x == 0);
+    CHECK(r->points->prev->x == 999);
+    CHECK(r->points->next->x == 1);
+    CHECK(r->size() == 1000);
+    CHECK(first->ring == r);
+}
+#endif
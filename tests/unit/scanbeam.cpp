@@ -0,0 +1,42 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <vector>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+TEST_CASE("scanbeam queues pop y values from largest to smallest") {
+    local_minimum_list<T> minima_list;
+    for (T y : { 5, 1, 9, 5 }) {
+        minima_list.emplace_back(bound<T>(), bound<T>(), y, false);
+    }
+
+    scanbeam_list<T> sorted;
+    setup_scanbeam_sorted(minima_list, sorted);
+    scanbeam_list<T> heap;
+    setup_scanbeam_heap(minima_list, heap);
+
+    std::vector<T> sorted_order;
+    std::vector<T> heap_order;
+    T y = 0;
+    REQUIRE(pop_from_scanbeam_sorted(y, sorted));
+    sorted_order.push_back(y);
+    REQUIRE(pop_from_scanbeam_heap(y, heap));
+    heap_order.push_back(y);
+    for (T t : { 7, 3, 7, 1 }) {
+        insert_scanbeam_sorted(sorted, t);
+        insert_scanbeam_heap(heap, t);
+    }
+    while (pop_from_scanbeam_sorted(y, sorted)) {
+        sorted_order.push_back(y);
+    }
+    while (pop_from_scanbeam_heap(y, heap)) {
+        heap_order.push_back(y);
+    }
+
+    // The sorted vector only keeps duplicates of local minima, the heap drops all of them
+    CHECK(sorted_order == std::vector<T>({ 9, 7, 5, 5, 3, 1 }));
+    CHECK(heap_order == std::vector<T>({ 9, 7, 5, 3, 1 }));
+}
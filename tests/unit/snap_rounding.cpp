@@ -0,0 +1,58 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+#include <cstddef>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+// A ring zigzagging back and forth across a square, crossing itself all over
+mapbox::geometry::linear_ring<T> zigzag(std::size_t vertices, T size, T step) {
+    mapbox::geometry::linear_ring<T> ring;
+    T x = 0;
+    T y = 0;
+    for (std::size_t i = 0; i < vertices; ++i) {
+        ring.push_back({ x, y });
+        x = (x + step * 7 + static_cast<T>(i % 3)) % size;
+        y = (y + step) % size;
+    }
+    ring.push_back(ring.front());
+    return ring;
+}
+} // namespace
+
+TEST_CASE("hot pixels found in bands match the sweep") {
+    local_minimum_list<T> minima_list;
+    add_linear_ring(zigzag(500, 1000, 37), minima_list, polygon_type_subject);
+    add_linear_ring(zigzag(300, 800, 13), minima_list, polygon_type_clip);
+
+    ring_manager<T> expected;
+    build_hot_pixels(minima_list, expected);
+    REQUIRE(expected.hot_pixels.size() > 1000);
+    for (std::size_t bands : { 2, 3, 7 }) {
+        ring_manager<T> banded;
+        build_hot_pixels_in_bands(sort_local_minima(minima_list), banded, bands, get_default_resource());
+        CHECK(banded.hot_pixels == expected.hot_pixels);
+    }
+}
+
+TEST_CASE("a single polygon clipped on several threads gives the same result") {
+    mapbox::geometry::polygon<T> subject = { zigzag(9000, 100000, 997) };
+    mapbox::geometry::polygon<T> clip = { zigzag(2000, 50000, 271) };
+    wagyu<T> serial;
+    wagyu<T> threaded;
+    threaded.set_threads(3);
+    serial.add_polygon(subject, polygon_type_subject);
+    serial.add_polygon(clip, polygon_type_clip);
+    threaded.add_polygon(subject, polygon_type_subject);
+    threaded.add_polygon(clip, polygon_type_clip);
+
+    mapbox::geometry::multi_polygon<T> expected;
+    mapbox::geometry::multi_polygon<T> solution;
+    serial.execute(clip_type_union, expected, fill_type_non_zero, fill_type_non_zero);
+    threaded.execute(clip_type_union, solution, fill_type_non_zero, fill_type_non_zero);
+    CHECK(solution == expected);
+}
@@ -0,0 +1,217 @@
+#include "catch.hpp"
+
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+using namespace mapbox::geometry::wagyu;
+using T = std::int64_t;
+
+namespace {
+
+// Runs everything up to topology correction for a checkerboard, the squares of which only touch
+// at their corners so that the rings of the union repeat points
+void build_checkerboard_rings(local_minimum_list<T>& minima_list, ring_manager<T>& manager) {
+    for (T i = 0; i < 12; ++i) {
+        for (T j = 0; j < 12; ++j) {
+            if ((i + j) % 2 != 0) {
+                continue;
+            }
+            T x = i * 10;
+            T y = j * 10;
+            mapbox::geometry::linear_ring<T> ring = {
+                { x, y }, { x + 10, y }, { x + 10, y + 10 }, { x, y + 10 }, { x, y }
+            };
+            add_linear_ring(ring, minima_list, polygon_type_subject);
+        }
+    }
+    build_hot_pixels(minima_list, manager);
+    execute_vatti(minima_list, manager, clip_type_union, fill_type_even_odd, fill_type_even_odd);
+}
+
+double ring_area(mapbox::geometry::linear_ring<T> const& ring) {
+    double area = 0.0;
+    for (std::size_t i = 1; i < ring.size(); ++i) {
+        area += static_cast<double>(ring[i - 1].x + ring[i].x) * static_cast<double>(ring[i - 1].y - ring[i].y);
+    }
+    return area * 0.5;
+}
+} // namespace
+
+TEST_CASE("correcting self intersections on several threads gives the same rings") {
+    local_minimum_list<T> serial_minima;
+    local_minimum_list<T> threaded_minima;
+    ring_manager<T> serial;
+    ring_manager<T> threaded;
+    build_checkerboard_rings(serial_minima, serial);
+    build_checkerboard_rings(threaded_minima, threaded);
+
+    // Each manager has to be bound again when compact links are used
+    mapbox::geometry::multi_polygon<T> expected;
+    mapbox::geometry::multi_polygon<T> solution;
+    serial.bind_pools();
+    correct_topology(serial);
+    build_result(expected, serial, false);
+    threaded.bind_pools();
+    correct_topology(threaded, 4);
+    build_result(solution, threaded, false);
+    CHECK(threaded.index == serial.index);
+    CHECK(expected.size() > 1);
+    CHECK(solution == expected);
+}
+
+TEST_CASE("ring connections are kept by ring index and searches start with no rings visited") {
+    ring_manager<T> manager;
+    ring_ptr<T> r1 = create_new_ring(manager);
+    ring_ptr<T> r2 = create_new_ring(manager);
+    point_ptr<T> p1 = create_new_point(r1, mapbox::geometry::point<T>(0, 0), manager);
+    point_ptr<T> p2 = create_new_point(r2, mapbox::geometry::point<T>(0, 0), manager);
+    point_ptr<T> p3 = create_new_point(r2, mapbox::geometry::point<T>(1, 1), manager);
+
+    ring_connection_map<T> connection_map;
+    connection_map.add(r2, point_ptr_pair<T>(p2, p1));
+    connection_map.add(r2, point_ptr_pair<T>(p3, p1));
+    connection_map.reserve(manager.index);
+    CHECK(connection_map[r1].empty());
+    REQUIRE(connection_map[r2].size() == 2);
+    // The newest connection is looked at first, from the back
+    CHECK(connection_map[r2].back().op1 == p3);
+
+    auto& visited = connection_map.visited;
+    visited.clear(manager.index);
+    visited.insert(r1);
+    CHECK(visited.contains(r1));
+    CHECK_FALSE(visited.contains(r2));
+    visited.clear(manager.index);
+    CHECK_FALSE(visited.contains(r1));
+}
+
+TEST_CASE("chained rings are split along a loop of holes that touch at their corners") {
+    // Four holes around a square, each touching the next at a corner, so that the search for a
+    // loop of connections has to go through all of them to find the island they enclose
+    mapbox::geometry::polygon<T> poly = { { { 0, 0 }, { 50, 0 }, { 50, 50 }, { 0, 50 }, { 0, 0 } } };
+    for (auto const& cell : { mapbox::geometry::point<T>(0, 1), mapbox::geometry::point<T>(1, 0),
+                              mapbox::geometry::point<T>(1, 2), mapbox::geometry::point<T>(2, 1) }) {
+        T x = 10 + 10 * cell.x;
+        T y = 10 + 10 * cell.y;
+        poly.push_back({ { x, y }, { x, y + 10 }, { x + 10, y + 10 }, { x + 10, y }, { x, y } });
+    }
+    wagyu<T> clipper;
+    clipper.add_polygon(poly, polygon_type_subject);
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    CHECK((clipper.get_topology_phases() & topology_phase_chained_rings) != 0);
+
+    // The holes become a single cross shaped hole around the island in the middle
+    mapbox::geometry::multi_polygon<T> expected = {
+        { { { 50, 0 }, { 50, 50 }, { 0, 50 }, { 0, 0 }, { 50, 0 } },
+          { { 30, 20 },
+            { 30, 10 },
+            { 20, 10 },
+            { 20, 20 },
+            { 10, 20 },
+            { 10, 30 },
+            { 20, 30 },
+            { 20, 40 },
+            { 30, 40 },
+            { 30, 30 },
+            { 40, 30 },
+            { 40, 20 },
+            { 30, 20 } } },
+        { { { 30, 20 }, { 30, 30 }, { 20, 30 }, { 20, 20 }, { 30, 20 } } }
+    };
+    CHECK(solution == expected);
+}
+
+TEST_CASE("ring stats kept up to date by the sweep match a walk of the points") {
+    local_minimum_list<T> minima_list;
+    ring_manager<T> manager;
+    build_checkerboard_rings(minima_list, manager);
+
+    std::size_t rings = 0;
+    for (auto& r : manager.rings) {
+        if (!r.points) {
+            continue;
+        }
+        ++rings;
+        REQUIRE(r.stats_known());
+        std::size_t size;
+        mapbox::geometry::box<T> bbox({ 0, 0 }, { 0, 0 });
+        double area = area_from_point(r.points, size, bbox);
+        CHECK(r.area() == Approx(area).epsilon(0.0));
+        CHECK(r.size() == size);
+        CHECK(r.bbox == bbox);
+    }
+    CHECK(rings > 0);
+}
+
+TEST_CASE("topology correction skips the phases with no repeated points to work on") {
+    mapbox::geometry::polygon<T> square = { { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } } };
+    mapbox::geometry::polygon<T> box = { { { 5, -5 }, { 20, -5 }, { 20, 20 }, { 5, 20 }, { 5, -5 } } };
+    wagyu<T> clipper;
+    clipper.add_polygon(square, polygon_type_subject);
+    clipper.add_polygon(box, polygon_type_clip);
+    mapbox::geometry::multi_polygon<T> solution;
+    clipper.execute(clip_type_intersection, solution, fill_type_even_odd, fill_type_even_odd);
+    CHECK(solution.size() == 1);
+    CHECK(clipper.get_topology_phases() == (topology_phase_orientations | topology_phase_tree));
+
+    wagyu<T> checkerboard;
+    for (T i = 0; i < 4; ++i) {
+        for (T j = i % 2; j < 4; j += 2) {
+            mapbox::geometry::polygon<T> cell = {
+                { { i, j }, { i + 1, j }, { i + 1, j + 1 }, { i, j + 1 }, { i, j } }
+            };
+            checkerboard.add_polygon(cell, polygon_type_subject);
+        }
+    }
+    checkerboard.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    CHECK(checkerboard.get_topology_phases() ==
+          (topology_phase_orientations | topology_phase_collinear_edges | topology_phase_self_intersections |
+           topology_phase_tree | topology_phase_chained_rings));
+}
+
+TEST_CASE("output for rendering keeps the area and orientation of the rings") {
+    // A checkerboard next to a square with a hole that touches its outer ring
+    auto add_input = [](wagyu<T>& clipper) {
+        for (T i = 0; i < 4; ++i) {
+            for (T j = i % 2; j < 4; j += 2) {
+                mapbox::geometry::polygon<T> cell = {
+                    { { i, j }, { i + 1, j }, { i + 1, j + 1 }, { i, j + 1 }, { i, j } }
+                };
+                clipper.add_polygon(cell, polygon_type_subject);
+            }
+        }
+        mapbox::geometry::polygon<T> square = { { { 10, 0 }, { 20, 0 }, { 20, 10 }, { 10, 10 }, { 10, 0 } },
+                                                { { 10, 5 }, { 15, 8 }, { 15, 2 }, { 10, 5 } } };
+        clipper.add_polygon(square, polygon_type_subject);
+    };
+    wagyu<T> full;
+    wagyu<T> render;
+    render.set_render_output(true);
+    add_input(full);
+    add_input(render);
+    mapbox::geometry::multi_polygon<T> expected;
+    mapbox::geometry::multi_polygon<T> solution;
+    full.execute(clip_type_union, expected, fill_type_even_odd, fill_type_even_odd);
+    render.execute(clip_type_union, solution, fill_type_even_odd, fill_type_even_odd);
+    CHECK((render.get_topology_phases() & topology_phase_tree) == 0);
+
+    auto total_area = [](mapbox::geometry::multi_polygon<T> const& mp) {
+        double area = 0.0;
+        for (auto const& poly : mp) {
+            for (auto const& ring : poly) {
+                area += ring_area(ring);
+            }
+        }
+        return area;
+    };
+    CHECK(total_area(solution) == Approx(total_area(expected)));
+    REQUIRE(!expected.empty());
+    bool outer_positive = ring_area(expected.front().front()) > 0.0;
+    for (auto const& poly : solution) {
+        REQUIRE(!poly.empty());
+        CHECK((ring_area(poly.front()) > 0.0) == outer_positive);
+        for (std::size_t i = 1; i < poly.size(); ++i) {
+            CHECK((ring_area(poly[i]) > 0.0) != outer_positive);
+        }
+    }
+}
@@ -417,3 +417,36 @@ TEST_CASE("Test crash with two quads") {
     clipper.execute(clip_type::clip_type_union, solution, fill_type::fill_type_non_zero, fill_type::fill_type_non_zero);
     REQUIRE(!solution.empty());
 }
+
+TEST_CASE("several operations on the same input match separate runs") {
+    mapbox::geometry::polygon<T> subject = { { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } } };
+    mapbox::geometry::polygon<T> clip = { { { 5, 5 }, { 15, 3 }, { 12, 15 }, { 5, 5 } } };
+    mapbox::geometry::polygon<T> extra = { { { 20, 20 }, { 30, 20 }, { 30, 30 }, { 20, 20 } } };
+
+    auto run = [&](wagyu<T>& clipper, clip_type ct) {
+        mapbox::geometry::multi_polygon<T> solution;
+        clipper.execute(ct, solution, fill_type_even_odd, fill_type_even_odd);
+        return solution;
+    };
+
+    wagyu<T> shared;
+    shared.add_polygon(subject, polygon_type_subject);
+    shared.add_polygon(clip, polygon_type_clip);
+    for (auto ct : { clip_type_union, clip_type_intersection, clip_type_difference, clip_type_x_or,
+                     clip_type_union }) {
+        wagyu<T> separate;
+        separate.add_polygon(subject, polygon_type_subject);
+        separate.add_polygon(clip, polygon_type_clip);
+        CHECK(run(shared, ct) == run(separate, ct));
+    }
+
+    // Adding more input after an execution is picked up by the next one
+    shared.add_polygon(extra, polygon_type_subject);
+    wagyu<T> separate;
+    separate.add_polygon(subject, polygon_type_subject);
+    separate.add_polygon(clip, polygon_type_clip);
+    separate.add_polygon(extra, polygon_type_subject);
+    auto solution = run(shared, clip_type_union);
+    CHECK(solution.size() == 2);
+    CHECK(solution == run(separate, clip_type_union));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+
+#include <mapbox/geometry/multi_polygon.hpp>
+#include <mapbox/geometry/wagyu/wagyu.hpp>
+
+// Small random rings on a 20 by 20 grid, which cross and touch often enough for every phase of
+// topology correction to change them
+template <typename T>
+mapbox::geometry::multi_polygon<T> random_input(std::mt19937& rng) {
+    mapbox::geometry::multi_polygon<T> mp(1 + rng() % 3);
+    for (auto& poly : mp) {
+        poly.emplace_back();
+        auto& ring = poly.back();
+        for (std::size_t i = 3 + rng() % 8; i > 0; --i) {
+            ring.push_back({ static_cast<T>(rng() % 21), static_cast<T>(rng() % 21) });
+        }
+        ring.push_back(ring.front());
+    }
+    return mp;
+}
+
+// Adds random subject and clip polygons
+template <typename T>
+void add_random_input(mapbox::geometry::wagyu::wagyu<T>& clipper, std::mt19937& rng) {
+    for (auto const& poly : random_input<T>(rng)) {
+        clipper.add_polygon(poly, mapbox::geometry::wagyu::polygon_type_subject);
+    }
+    for (auto const& poly : random_input<T>(rng)) {
+        clipper.add_polygon(poly, mapbox::geometry::wagyu::polygon_type_clip);
+    }
+}